@@ -0,0 +1,80 @@
+#include "BenchFixtures.h"
+#include "ResourceDecoders.h"
+#include "ResourceWriter.h"
+#include <fstream>
+#include <map>
+#include <random>
+#include <stdexcept>
+
+namespace BenchFixtures {
+
+const std::filesystem::path& TempDirectory() {
+    static const std::filesystem::path directory = [] {
+        auto path = std::filesystem::temp_directory_path() / "wime-bench";
+        std::filesystem::create_directories(path);
+        return path;
+    }();
+    return directory;
+}
+
+std::string RandomFile(size_t size) {
+    static std::map<size_t, std::string> created;
+    auto existing = created.find(size);
+    if (existing != created.end()) return existing->second;
+
+    std::vector<uint8_t> bytes(size);
+    std::mt19937 random(1234);
+    for (auto& byte : bytes) byte = static_cast<uint8_t>(random());
+
+    std::string path = (TempDirectory() / ("random-" + std::to_string(size) + ".bin")).string();
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    return created[size] = path;
+}
+
+std::string ResourceFile(size_t entries, Endianness endian) {
+    static std::map<std::pair<size_t, Endianness>, std::string> created;
+    auto existing = created.find({entries, endian});
+    if (existing != created.end()) return existing->second;
+
+    // Small chunks keep large entry counts inside the 16 MB offset range
+    static const char* types[] = {"CSTR", "CHAR", "MMAP"};
+    std::vector<ResourceChunk> chunks(entries);
+    for (size_t i = 0; i < entries; ++i) {
+        chunks[i].typeID = types[i % 3];
+        chunks[i].number = static_cast<uint16_t>(i / 3);
+        chunks[i].payload.assign(32 + i % 64, static_cast<uint8_t>(i));
+    }
+
+    std::string path = (TempDirectory() / ("entries-" + std::to_string(entries)
+                        + (endian == Endianness::Little ? "-le.res" : "-be.res"))).string();
+    std::string error;
+    if (!ResourceWriter::WriteResourceFile(path, endian, chunks, error)) {
+        throw std::runtime_error(error);
+    }
+    return created[{entries, endian}] = path;
+}
+
+std::vector<uint8_t> TileData() {
+    std::vector<uint8_t> data(ResourceDecoders::TILE_COUNT * ResourceDecoders::TILE_BYTES);
+    std::mt19937 random(42);
+    for (auto& byte : data) byte = static_cast<uint8_t>(random());
+    return data;
+}
+
+std::vector<uint8_t> MapCells(uint32_t gridWidth, uint32_t gridHeight) {
+    std::vector<uint8_t> cells(static_cast<size_t>(gridWidth) * gridHeight);
+    std::mt19937 random(7);
+    size_t i = 0;
+    while (i < cells.size()) {
+        // Alternate runs of one tile (terrain) and stretches of mixed tiles (detail)
+        size_t run = 1 + random() % 24;
+        uint8_t tile = static_cast<uint8_t>(random());
+        bool repeated = random() % 2 == 0;
+        for (size_t n = 0; n < run && i < cells.size(); ++n, ++i) {
+            cells[i] = repeated ? tile : static_cast<uint8_t>(random());
+        }
+    }
+    return cells;
+}
+
+}  // namespace BenchFixtures
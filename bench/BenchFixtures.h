@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "BinaryFile.h"
+
+// Synthetic inputs shared by the benchmarks. Files are written to a temp
+// directory on first use and reused across iterations and benchmark cases.
+namespace BenchFixtures {
+
+// Directory for generated files, created on first use
+const std::filesystem::path& TempDirectory();
+
+// File of `size` pseudo-random bytes, created once per size
+std::string RandomFile(size_t size);
+
+// Valid .res file with `entries` chunks (mixed CSTR/CHAR/MMAP), created once per count and byte order
+std::string ResourceFile(size_t entries, Endianness endian);
+
+// 256 tiles of 4bpp data, as stored in a CHAR chunk
+std::vector<uint8_t> TileData();
+
+// Map grid of tile numbers with runs of repeated tiles, as real maps have
+std::vector<uint8_t> MapCells(uint32_t gridWidth, uint32_t gridHeight);
+
+}  // namespace BenchFixtures
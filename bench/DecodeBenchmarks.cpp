@@ -0,0 +1,108 @@
+// Pure decoders from ResourceDecoders and the PNG encoder used by the exporter
+#include <benchmark/benchmark.h>
+#include "BenchFixtures.h"
+#include "PngWriter.h"
+#include "ResourceDecoders.h"
+#include "ResourceWriter.h"
+
+namespace {
+
+void BM_DecodeByteRun(benchmark::State& state) {
+    const uint32_t gridWidth = static_cast<uint32_t>(state.range(0));
+    const uint32_t gridHeight = static_cast<uint32_t>(state.range(1));
+    std::vector<uint8_t> cells = BenchFixtures::MapCells(gridWidth, gridHeight);
+    std::vector<uint8_t> encoded = ResourceWriter::EncodeByteRun(cells.data(), cells.size());
+    std::vector<uint8_t> decoded(cells.size());
+    for (auto _ : state) {
+        size_t written = ResourceDecoders::DecodeByteRun(encoded.data(), encoded.size(), decoded.data(), decoded.size());
+        benchmark::DoNotOptimize(written);
+    }
+    if (decoded != cells) state.SkipWithError("ByteRun round trip mismatch");
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * cells.size());
+}
+BENCHMARK(BM_DecodeByteRun)->ArgNames({"w", "h"})->Args({160, 99})->Args({512, 512})->Args({2048, 2048});
+
+void BM_DecodeTile(benchmark::State& state) {
+    std::vector<uint8_t> tileData = BenchFixtures::TileData();
+    uint8_t tile[ResourceDecoders::TILE_SIZE * ResourceDecoders::TILE_SIZE];
+    for (auto _ : state) {
+        for (size_t i = 0; i < ResourceDecoders::TILE_COUNT; ++i) {
+            ResourceDecoders::DecodeTile(tileData, i, tile);
+            benchmark::DoNotOptimize(tile);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * ResourceDecoders::TILE_COUNT);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * tileData.size());
+}
+BENCHMARK(BM_DecodeTile);
+
+void BM_BuildTileAtlas(benchmark::State& state) {
+    std::vector<uint8_t> tileData = BenchFixtures::TileData();
+    for (auto _ : state) {
+        IndexedImage atlas = ResourceDecoders::BuildTileAtlas(tileData);
+        benchmark::DoNotOptimize(atlas.pixels.data());
+    }
+}
+BENCHMARK(BM_BuildTileAtlas);
+
+void BM_ComposeMap(benchmark::State& state) {
+    MapCells map;
+    map.gridWidth = static_cast<uint32_t>(state.range(0));
+    map.gridHeight = static_cast<uint32_t>(state.range(1));
+    map.cells = BenchFixtures::MapCells(map.gridWidth, map.gridHeight);
+    IndexedImage atlas = ResourceDecoders::BuildTileAtlas(BenchFixtures::TileData());
+    for (auto _ : state) {
+        IndexedImage image = ResourceDecoders::ComposeMap(map, atlas);
+        benchmark::DoNotOptimize(image.pixels.data());
+    }
+    const int64_t pixels = static_cast<int64_t>(map.gridWidth) * map.gridHeight
+                         * ResourceDecoders::TILE_SIZE * ResourceDecoders::TILE_SIZE;
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * pixels);
+}
+BENCHMARK(BM_ComposeMap)->ArgNames({"w", "h"})->Args({40, 25})->Args({160, 99})->Args({512, 512})
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_ExpandPalette(benchmark::State& state) {
+    IndexedImage atlas = ResourceDecoders::BuildTileAtlas(BenchFixtures::TileData());
+    std::vector<uint32_t> rgba;
+    for (auto _ : state) {
+        ResourceDecoders::ExpandPalette(atlas, rgba);
+        benchmark::DoNotOptimize(rgba.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * atlas.pixels.size());
+}
+BENCHMARK(BM_ExpandPalette);
+
+void BM_DecodePlanar(benchmark::State& state) {
+    const uint32_t width = 320, height = 200, planes = static_cast<uint32_t>(state.range(0));
+    std::vector<uint8_t> data(ResourceDecoders::PlanarImageBytes(width, height, planes));
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 37);
+    IndexedImage image;
+    for (auto _ : state) {
+        bool ok = ResourceDecoders::DecodePlanar(data.data(), data.size(), width, height, planes, image);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * width * height);
+}
+BENCHMARK(BM_DecodePlanar)->Arg(4)->Arg(5);
+
+void BM_EncodePng(benchmark::State& state) {
+    MapCells map;
+    map.gridWidth = 160;
+    map.gridHeight = 99;
+    map.cells = BenchFixtures::MapCells(map.gridWidth, map.gridHeight);
+    IndexedImage image = ResourceDecoders::ComposeMap(map, ResourceDecoders::BuildTileAtlas(BenchFixtures::TileData()));
+    const auto& palette = ResourceDecoders::GetPalette();
+    const int level = static_cast<int>(state.range(0));
+    size_t encodedSize = 0;
+    for (auto _ : state) {
+        std::vector<uint8_t> png = PngWriter::EncodeIndexed(image, palette.data(), palette.size(), level);
+        encodedSize = png.size();
+        benchmark::DoNotOptimize(png.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * image.pixels.size());
+    state.counters["ratio"] = static_cast<double>(image.pixels.size()) / std::max<size_t>(encodedSize, 1);
+}
+BENCHMARK(BM_EncodePng)->ArgName("level")->Arg(1)->Arg(6)->Unit(benchmark::kMillisecond);
+
+}  // namespace
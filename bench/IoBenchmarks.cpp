@@ -0,0 +1,83 @@
+// BinaryFile access patterns and ResourceLoader parsing
+#include <benchmark/benchmark.h>
+#include "BenchFixtures.h"
+#include "BinaryFile.h"
+#include "MappedFile.h"
+#include "ResourceLoader.h"
+
+namespace {
+
+// One ReadByteUnsigned call per byte, as the pre-bulk viewers did
+void BM_BinaryFile_ScalarBytes(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    std::string path = BenchFixtures::RandomFile(size);
+    for (auto _ : state) {
+        BinaryFile file(path);
+        uint32_t sum = 0;
+        for (size_t i = 0; i < size; ++i) sum += file.ReadByteUnsigned();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+BENCHMARK(BM_BinaryFile_ScalarBytes)->Arg(64 << 10)->Arg(1 << 20);
+
+// One ReadWordUnsigned call per word, as the loader reads headers and key tables
+void BM_BinaryFile_ScalarWords(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    std::string path = BenchFixtures::RandomFile(size);
+    for (auto _ : state) {
+        BinaryFile file(path);
+        uint32_t sum = 0;
+        for (size_t i = 0; i + 2 <= size; i += 2) sum += file.ReadWordUnsigned(Endianness::Big);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+BENCHMARK(BM_BinaryFile_ScalarWords)->Arg(64 << 10)->Arg(1 << 20);
+
+void BM_BinaryFile_BulkRead(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    std::string path = BenchFixtures::RandomFile(size);
+    for (auto _ : state) {
+        BinaryFile file(path);
+        std::vector<uint8_t> bytes = file.ReadBytes(size);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+BENCHMARK(BM_BinaryFile_BulkRead)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+// Map and touch every page, as search and export do
+void BM_MappedFile_Scan(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    std::string path = BenchFixtures::RandomFile(size);
+    for (auto _ : state) {
+        MappedFile file(path);
+        uint32_t sum = 0;
+        for (size_t i = 0; i < file.Size(); i += 4096) sum += file.Data()[i];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+BENCHMARK(BM_MappedFile_Scan)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+void BM_ResourceLoader_Load(benchmark::State& state) {
+    const size_t entries = static_cast<size_t>(state.range(0));
+    const Endianness endian = state.range(1) ? Endianness::Big : Endianness::Little;
+    std::string path = BenchFixtures::ResourceFile(entries, endian);
+    for (auto _ : state) {
+        auto index = ResourceLoader::LoadResourceFile(path, endian);
+        if (!index || index->items.size() != entries) {
+            state.SkipWithError("Synthetic resource file did not load");
+            break;
+        }
+        benchmark::DoNotOptimize(index.get());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * entries);
+}
+BENCHMARK(BM_ResourceLoader_Load)
+    ->ArgNames({"entries", "bigEndian"})
+    ->ArgsProduct({{100, 1000, 10000, 100000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
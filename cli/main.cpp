@@ -0,0 +1,284 @@
+// wime-cli: headless access to a game's resources for scripts and build machines.
+// Links only the loader and analysis code; no window, GL context or ImGui.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Game.h"
+#include "MappedFile.h"
+#include "ResourceAnalysis.h"
+#include "ResourceExporter.h"
+#include "ResourceIndex.h"
+#include "ResourceIndexCache.h"
+#include "ResourceLoader.h"
+
+namespace {
+
+struct Options {
+    std::string gamePath;
+    std::string command;
+    std::vector<std::string> arguments;
+    std::vector<ResourceType> types;  // Empty means all types
+    unsigned jobs = 0;                // 0 means hardware concurrency
+    int compressionLevel = 1;
+    bool verbose = false;
+    bool useCache = true;
+};
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: wime-cli <game-file> <command> [options]\n"
+        "\n"
+        "Commands:\n"
+        "  list                 One line per resource: name, type, file, offset, size\n"
+        "  stats                Counts, sizes and byte entropy per resource type\n"
+        "  export <out-dir>     Write every resource to <out-dir>/<res-file>/<TYPE>_<number>.bin\n"
+        "                       (CSTR resources are also written as .txt)\n"
+        "  export-images <out-dir>\n"
+        "                       Decode every CHAR, IMAG and MMAP and write them as\n"
+        "                       <out-dir>/<res-file>/<TYPE>_<number>.png\n"
+        "\n"
+        "Options:\n"
+        "  --type <ID>          Only resources of this chunk type (CHAR, CSTR, FONT, FRML, IMAG, MMAP);\n"
+        "                       may be repeated\n"
+        "  --jobs <n>           Export threads (default: number of cores)\n"
+        "  --level <0-9>        PNG compression level for export-images (default: 1)\n"
+        "  --no-cache           Parse every .res file instead of using the index cache\n"
+        "  --verbose            Print loader diagnostics to stderr\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--type" && i + 1 < argc) {
+            ResourceType type;
+            if (!ParseResourceTypeID(argv[++i], type)) {
+                std::fprintf(stderr, "Unknown resource type: %s\n", argv[i]);
+                return false;
+            }
+            options.types.push_back(type);
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            options.jobs = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--level" && i + 1 < argc) {
+            options.compressionLevel = std::clamp(std::atoi(argv[++i]), 0, 9);
+        } else if (arg == "--verbose") {
+            options.verbose = true;
+        } else if (arg == "--no-cache") {
+            options.useCache = false;
+        } else if (arg.rfind("--", 0) == 0) {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() < 2) return false;
+    options.gamePath = positional[0];
+    options.command = positional[1];
+    options.arguments.assign(positional.begin() + 2, positional.end());
+    return true;
+}
+
+std::vector<std::shared_ptr<ResourceItem>> SelectItems(const ResourceIndex& index, const Options& options) {
+    if (options.types.empty()) return index.items;
+    std::vector<std::shared_ptr<ResourceItem>> selected;
+    for (const auto& item : index.items) {
+        if (std::find(options.types.begin(), options.types.end(), item->type) != options.types.end()) {
+            selected.push_back(item);
+        }
+    }
+    return selected;
+}
+
+// One mapping per .res file, shared read-only by all worker threads
+std::map<std::string, std::unique_ptr<MappedFile>> MapSourceFiles(const std::vector<std::shared_ptr<ResourceItem>>& items) {
+    std::vector<std::string> errors;
+    auto files = ResourceAnalysis::MapSourceFiles(items, errors);
+    for (const auto& error : errors) std::fprintf(stderr, "%s\n", error.c_str());
+    return files;
+}
+
+int RunList(const std::vector<std::shared_ptr<ResourceItem>>& items) {
+    for (const auto& item : items) {
+        std::printf("%s\t%s\t%s\t0x%08X\t%u\n", item->name.c_str(), GetResourceTypeID(item->type),
+                    std::filesystem::path(item->sourceFile).filename().string().c_str(), item->offset, item->size);
+    }
+    return 0;
+}
+
+int RunStats(const std::vector<std::shared_ptr<ResourceItem>>& items) {
+    std::map<std::string, TypeStatistics> byType;
+    auto files = MapSourceFiles(items);
+    ResourceAnalysis::ComputeTypeStatistics(items, files, byType);
+
+    std::printf("%-6s %8s %12s %10s %10s %8s %8s\n", "Type", "Count", "Bytes", "Min", "Max", "Unique", "Entropy");
+    size_t totalCount = 0;
+    uint64_t totalBytes = 0;
+    for (const auto& [type, stats] : byType) {
+        std::printf("%-6s %8zu %12llu %10u %10u %8zu %8.3f\n", type.c_str(), stats.count,
+                    static_cast<unsigned long long>(stats.bytes), stats.smallest, stats.largest,
+                    stats.content.uniqueValues, stats.content.entropy);
+        totalCount += stats.count;
+        totalBytes += stats.bytes;
+    }
+    std::printf("%-6s %8zu %12llu\n", "Total", totalCount, static_cast<unsigned long long>(totalBytes));
+    std::printf("Files: %zu\n", files.size());
+    return 0;
+}
+
+bool WriteFile(const std::filesystem::path& path, const uint8_t* data, size_t size) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(data), size);
+    return static_cast<bool>(out);
+}
+
+int RunExport(const std::vector<std::shared_ptr<ResourceItem>>& items, const Options& options) {
+    if (options.arguments.empty()) {
+        PrintUsage();
+        return 1;
+    }
+    const std::filesystem::path outDir = options.arguments[0];
+    auto files = MapSourceFiles(items);
+
+    // Create every output directory up front so workers only write files
+    for (const auto& entry : files) {
+        std::error_code ec;
+        std::filesystem::create_directories(outDir / std::filesystem::path(entry.first).stem(), ec);
+        if (ec) {
+            std::fprintf(stderr, "Cannot create %s: %s\n", (outDir / std::filesystem::path(entry.first).stem()).string().c_str(), ec.message().c_str());
+            return 2;
+        }
+    }
+
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> written{0};
+    std::atomic<size_t> failed{0};
+    std::atomic<uint64_t> bytesWritten{0};
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < items.size(); i = next++) {
+            const ResourceItem& item = *items[i];
+            auto file = files.find(item.sourceFile);
+            const uint8_t* data;
+            size_t size;
+            if (file == files.end() || !ResourceAnalysis::ChunkBytes(*file->second, item, data, size)) {
+                failed++;
+                continue;
+            }
+
+            std::filesystem::path base = outDir / std::filesystem::path(item.sourceFile).stem()
+                                       / (std::string(GetResourceTypeID(item.type)) + "_" + std::to_string(item.number));
+            bool ok = WriteFile(base.string() + ".bin", data, size);
+            if (ok && item.type == ResourceType::CSTR && size > 4) {
+                ok = WriteFile(base.string() + ".txt", data + 4, size - 4);
+            }
+            if (ok) {
+                written++;
+                bytesWritten += size;
+            } else {
+                failed++;
+            }
+        }
+    };
+
+    unsigned jobs = options.jobs ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < jobs; ++i) threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("Exported %zu resources (%.1f MB) to %s in %.3f s with %u threads, %.1f MB/s\n",
+                written.load(), bytesWritten / 1048576.0, outDir.string().c_str(), seconds, jobs,
+                seconds > 0 ? bytesWritten / 1048576.0 / seconds : 0.0);
+    if (failed > 0) {
+        std::fprintf(stderr, "%zu resources could not be exported\n", failed.load());
+        return 2;
+    }
+    return 0;
+}
+
+int RunExportImages(const Game& game, const Options& options) {
+    if (options.arguments.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    ExportOptions exportOptions;
+    exportOptions.outputDirectory = options.arguments[0];
+    exportOptions.types = options.types;
+    exportOptions.threads = options.jobs;
+    exportOptions.compressionLevel = options.compressionLevel;
+
+    ExportProgress progress;
+    ExportResult result;
+    std::atomic<bool> finished{false};
+    std::thread worker([&] {
+        result = ResourceExporter::ExportImages(*game.resource, exportOptions, progress);
+        finished = true;
+    });
+
+    // Progress line on stderr so stdout stays clean for scripts
+    while (!finished) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::fprintf(stderr, "\r%zu/%zu images", progress.done.load(), progress.total.load());
+    }
+    worker.join();
+    std::fprintf(stderr, "\n");
+
+    for (const auto& error : result.errors) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+    }
+    std::printf("Exported %zu images (%.1f MB) to %s in %.3f s, %.1f images/s, %.1f MB/s; %zu skipped, %zu failed\n",
+                result.exported, result.bytesWritten / 1048576.0, exportOptions.outputDirectory.c_str(), result.seconds,
+                result.seconds > 0 ? result.exported / result.seconds : 0.0,
+                result.seconds > 0 ? result.bytesWritten / 1048576.0 / result.seconds : 0.0,
+                result.skipped, result.failed);
+    return result.failed > 0 ? 2 : 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    if (options.verbose) {
+        auto log = [](const std::string& message) { std::fprintf(stderr, "%s\n", message.c_str()); };
+        Game::SetDebugCallback(log);
+        ResourceLoader::SetDebugCallback(log);
+    }
+
+    if (!options.useCache) ResourceIndexCache::SetDirectory("");
+
+    Game game;
+    if (!game.LoadGame(options.gamePath) || !game.resource) {
+        std::fprintf(stderr, "Failed to load game: %s\n", options.gamePath.c_str());
+        return 2;
+    }
+    std::vector<std::shared_ptr<ResourceItem>> items = SelectItems(*game.resource, options);
+
+    if (options.command == "list") return RunList(items);
+    if (options.command == "stats") return RunStats(items);
+    if (options.command == "export") return RunExport(items, options);
+    if (options.command == "export-images") return RunExportImages(game, options);
+
+    std::fprintf(stderr, "Unknown command: %s\n", options.command.c_str());
+    PrintUsage();
+    return 1;
+}
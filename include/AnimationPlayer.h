@@ -0,0 +1,78 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "GpuTexture.h"
+
+// Plays a sequence of decoded frames. A worker thread decodes ahead into a fixed
+// ring of slots; the UI thread uploads finished slots to textures and advances the
+// playhead on a fixed clock. At most RING_SIZE frames are resident at any time.
+class AnimationPlayer {
+public:
+    // Decodes frame `frameIndex` into `pixels` (width*height RGBA). Called on the worker thread.
+    using FrameDecoder = std::function<bool(size_t frameIndex, std::vector<uint32_t>& pixels)>;
+
+    static constexpr size_t RING_SIZE = 8;
+
+    AnimationPlayer() = default;
+    ~AnimationPlayer();
+
+    AnimationPlayer(const AnimationPlayer&) = delete;
+    AnimationPlayer& operator=(const AnimationPlayer&) = delete;
+
+    void Start(size_t frameCount, int width, int height, double frameDuration, FrameDecoder decoder);
+    void Stop();
+
+    // UI thread: upload decoded frames and advance the clock. Never blocks on the worker.
+    void Update(double deltaTime);
+
+    void SetPlaying(bool play) { playing = play; }
+    bool IsPlaying() const { return playing; }
+    void SetFrameDuration(double seconds) { frameDuration = seconds; }
+    double GetFrameDuration() const { return frameDuration; }
+
+    bool HasFrame() const;
+    ImTextureID GetTexture() const;
+    size_t GetCurrentFrame() const;
+    size_t GetFrameCount() const { return frameCount; }
+    size_t GetDroppedFrames() const { return droppedFrames; }
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+private:
+    struct Slot {
+        uint64_t sequence = UINT64_MAX;  // Monotonic frame sequence number held by this slot
+        bool decoded = false;
+        bool uploaded = false;
+        std::vector<uint32_t> pixels;
+        GpuTexture texture;
+    };
+
+    std::vector<Slot> slots;
+    FrameDecoder decoder;
+    size_t frameCount = 0;
+    int width = 0;
+    int height = 0;
+
+    // Shared with worker, guarded by mutex
+    std::mutex mutex;
+    std::condition_variable wake;
+    uint64_t playhead = 0;        // Sequence currently on screen
+    uint64_t nextToDecode = 0;
+    bool stopRequested = false;
+    std::thread worker;
+
+    // UI thread only
+    double frameDuration = 0.1;
+    double accumulator = 0.0;
+    bool playing = true;
+    bool hasShownFrame = false;
+    size_t droppedFrames = 0;
+
+    void WorkerLoop();
+    Slot& SlotFor(uint64_t sequence) { return slots[sequence % slots.size()]; }
+    const Slot& SlotFor(uint64_t sequence) const { return slots[sequence % slots.size()]; }
+};
@@ -9,17 +9,26 @@ enum class Endianness {
     Big
 };
 
+// ReadOnly opens with std::ios::in only, so read-only files and media work
+// and concurrent readers share the file; Write* calls throw in this mode
+enum class FileAccess {
+    ReadOnly,
+    ReadWrite
+};
+
 class BinaryFile {
 public:
-    BinaryFile(const std::string& filename);
+    BinaryFile(const std::string& filename, FileAccess access = FileAccess::ReadOnly);
     ~BinaryFile();
     
     // File operations
     bool IsOpen() const;
+    bool IsReadOnly() const { return access == FileAccess::ReadOnly; }
     std::string GetFilename() const;
     size_t GetPosition(); // removed const
     void SetPosition(size_t position);
     size_t GetLength(); // removed const
+    void Flush();
     
     // Byte operations
     uint8_t ReadByteUnsigned();
@@ -56,9 +65,11 @@ public:
 private:
     std::fstream file;
     std::string filename;
+    FileAccess access;
     
     // Helper functions
     void CheckEOF();
+    void CheckWritable();
     uint16_t SwapBytes(uint16_t value);
     uint32_t SwapBytes(uint32_t value);
 }; 
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LogBuffer.h"
+
+// Interpreter for the commands typed into the console.
+//
+// Commands are registered once into a table keyed by name. A line is split into
+// words ("quoted words" may contain spaces) and handed to the matching handler
+// on the UI thread. Handlers that take a while pass their work to RunAsync,
+// which runs one job at a time on a background thread and reports its progress
+// to the console about once a second. "help" and "cancel" are built in.
+class ConsoleCommands {
+public:
+    using Arguments = std::vector<std::string>;   // Words after the command name
+    using Handler = std::function<void(const Arguments& args)>;
+    // Must be safe to call from any thread
+    using Output = std::function<void(LogLevel level, const std::string& source, const std::string& message)>;
+
+    explicit ConsoleCommands(Output output);
+    ~ConsoleCommands();   // Cancels and waits for a running job
+
+    ConsoleCommands(const ConsoleCommands&) = delete;
+    ConsoleCommands& operator=(const ConsoleCommands&) = delete;
+
+    // usage is the synopsis shown by help, e.g. "find [-i] [-x] <pattern>"
+    void Register(const std::string& name, const std::string& usage, const std::string& description, Handler handler);
+    void Execute(const std::string& line);
+
+    // Splits on spaces; double quotes group words and \" is a literal quote.
+    // False with error set on an unterminated quote.
+    static bool Tokenize(const std::string& line, std::vector<std::string>& words, std::string& error);
+
+    // Starts work on the background thread. progress returns the finished fraction
+    // (0..1, negative if unknown) and cancel asks the work to stop early; both are
+    // called from the UI thread and may be empty. False if a job is already running.
+    bool RunAsync(const std::string& name, std::function<void()> work,
+                  std::function<double()> progress = nullptr, std::function<void()> cancel = nullptr);
+    bool IsBusy() const { return busy; }
+    void CancelJob();
+    // Cancels a running job and waits for its thread, so its output still has somewhere to go
+    void Stop();
+
+    // UI thread, once per frame: reports progress and reaps a finished job
+    void Update();
+
+    // Thread-safe; source is usually the command name
+    void Print(const std::string& source, const std::string& message) const { output(LogLevel::Info, source, message); }
+    void PrintWarning(const std::string& source, const std::string& message) const { output(LogLevel::Warning, source, message); }
+    void PrintError(const std::string& source, const std::string& message) const { output(LogLevel::Error, source, message); }
+
+    static constexpr std::chrono::seconds PROGRESS_REPORT_INTERVAL{1};
+
+private:
+    struct Command {
+        std::string usage;
+        std::string description;
+        Handler handler;
+    };
+
+    std::map<std::string, Command> commands;   // Sorted, so help lists them alphabetically
+    Output output;
+
+    // The running job; jobName and the callbacks are only touched on the UI thread
+    std::thread worker;
+    std::atomic<bool> busy{false};
+    std::atomic<bool> cancelRequested{false};
+    std::string jobName;
+    std::function<double()> jobProgress;
+    std::function<void()> jobCancel;
+    std::chrono::steady_clock::time_point lastReport;
+
+    void PrintHelp(const Arguments& args) const;
+};
@@ -1,8 +1,11 @@
 #pragma once
+#include <imgui.h>
 #include <string>
-#include <vector>
-#include <deque>
 #include <functional>
+#include <cstdint>
+#include <vector>
+#include "LogBuffer.h"
+#include "LogQueue.h"
 
 class ConsoleWindow {
 public:
@@ -10,24 +13,44 @@ public:
     ~ConsoleWindow();
     
     void Render();
+    // Once per frame, whether or not the window is shown: moves queued
+    // records into the log and writes the mirror
+    void Update();
     
-    // Console functionality
+    // Console functionality. Safe to call from any thread; messages appear
+    // when the UI thread next calls Update.
     void AddMessage(const std::string& message);
     void AddError(const std::string& error);
     void AddWarning(const std::string& warning);
+    void Post(LogLevel level, const std::string& source, const std::string& message);
+    // UI thread only
     void Clear();
     
+    // Mirroring is buffered and written by Update; stdout is on by default
+    void SetMirrorToStdout(bool enable) { mirror.SetStdout(enable); }
+    bool SetMirrorFile(const std::string& filename) { return mirror.SetFile(filename); }
+    
+    // Called from the posting thread when records arrive while the queue is empty
+    void SetOnMessagePosted(std::function<void()> callback) { queue.SetOnFirstPush(callback); }
+    
     // Command handling
     void SetCommandCallback(std::function<void(const std::string&)> callback);
     
 private:
-    std::deque<std::string> messages;
+    LogQueue queue;
+    LogBuffer log;
+    LogMirror mirror;
+    std::vector<LogRecord> drained;   // Reused by Update
     char inputBuffer[256];
     std::function<void(const std::string&)> commandCallback;
     bool scrollToBottom;
+    uint64_t renderedLines = 0;   // log.GetTotalAppended() at the last frame
+    
+    static constexpr ImU32 ERROR_COLOR = IM_COL32(0xFF, 0x44, 0x44, 0xFF);
+    static constexpr ImU32 WARNING_COLOR = IM_COL32(0xFF, 0xAA, 0x00, 0xFF);
     
     void RenderMessages();
     void RenderInput();
     void ExecuteCommand(const std::string& command);
-    void AddMessageWithColor(const std::string& message, const char* color);
-}; 
\ No newline at end of file
+    void Append(const LogRecord& record);
+};
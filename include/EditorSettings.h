@@ -10,6 +10,7 @@ public:
     int windowWidth;
     int windowHeight;
     bool windowMaximized;
+    bool powerSaving;       // Redraw only on input, animation or background progress
 
     EditorSettings();
 }; 
\ No newline at end of file
@@ -1,10 +1,15 @@
 #pragma once
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 #include "Game.h"
 #include "EditorSettings.h"
 #include "FileDialog.h"
+#include "StringIndex.h"
+#include "ResourceEdits.h"
+#include "ResourceSearch.h"
 
 // Forward declarations
 class GameInfoWindow;
@@ -12,6 +17,10 @@ class ResourceBrowserWindow;
 class PropertiesWindow;
 class PreviewWindow;
 class ConsoleWindow;
+class SearchWindow;
+class ExportWindow;
+class ProfilerWindow;
+class ConsoleCommands;
 
 class EditorUI {
 public:
@@ -41,15 +50,23 @@ public:
     void ShowProperties(bool show = true);
     void ShowPreview(bool show = true);
     void ShowConsole(bool show = true);
+    void ShowSearch(bool show = true);
     
     // Event callbacks
     void OnFileOpen(const std::string& filePath);
     void OnExit();
+    void OnSave();
+    void OnExportImages(const std::string& directory);
+    void OnSaveTrace(const std::string& filename);
     void OnAbout();
     
     // Menu handling
     bool ShouldOpenFile() const { return shouldOpenFile; }
     void ClearOpenFileFlag() { shouldOpenFile = false; }
+    bool ShouldExportImages() const { return shouldExportImages; }
+    void ClearExportImagesFlag() { shouldExportImages = false; }
+    bool ShouldSaveTrace() const { return shouldSaveTrace; }
+    void ClearSaveTraceFlag() { shouldSaveTrace = false; }
     
 private:
     // Window components
@@ -58,9 +75,17 @@ private:
     std::unique_ptr<PropertiesWindow> propertiesWindow;
     std::unique_ptr<PreviewWindow> previewWindow;
     std::unique_ptr<ConsoleWindow> consoleWindow;
+    std::unique_ptr<SearchWindow> searchWindow;
+    std::unique_ptr<ExportWindow> exportWindow;
+    std::unique_ptr<ProfilerWindow> profilerWindow;
+    std::unique_ptr<ConsoleCommands> consoleCommands;
     
     // State
     std::unique_ptr<Game> currentGame;
+    std::shared_ptr<ResourceItem> selectedResource;
+    StringIndex stringIndex;
+    ResourceEdits resourceEdits;
+    std::set<std::string> deferredReloads;   // Changed on disk while they had unsaved edits
     EditorSettings settings;
     bool gameLoaded;
     
@@ -73,12 +98,41 @@ private:
     bool showProperties;
     bool showPreview;
     bool showConsole;
+    bool showSearch;
+    bool showExport;
+    bool showProfiler;
     
     // Menu state
     bool shouldOpenFile;
+    bool shouldExportImages;
+    bool shouldSaveTrace;
+    
+    // Results of the last console find, written by its job and read by select #n
+    std::mutex findMutex;
+    std::vector<SearchHit> findHits;
+    size_t findPatternLength = 0;
     
     // Private methods
     void RenderMainMenuBar();
     void RenderDockSpace();
     void SetupDockSpace();
+    void SelectResource(const std::shared_ptr<ResourceItem>& resource);
+    // Applies a .res file rewritten by another program to the open game
+    void ReloadChangedResourceFile(const std::string& resFile);
+    // Reloads deferred files whose edits have since been reverted
+    void ReloadDeferredResourceFiles();
+    // Drops what was decoded from resFile and moves the selection to the new entries
+    void ApplyResourceFileChanges(const std::string& resFile, const ResourceFileChanges& changes);
+    
+    // Console commands
+    void RegisterConsoleCommands();
+    void RunFindCommand(const std::vector<std::string>& args);
+    void RunSelectCommand(const std::vector<std::string>& args);
+    void RunExportCommand(const std::vector<std::string>& args);
+    void RunStatsCommand(const std::vector<std::string>& args);
+    void RunBenchCommand(const std::vector<std::string>& args);
+    void RunReloadCommand(const std::vector<std::string>& args);
+    
+    static constexpr size_t MAX_LISTED_HITS = 20;      // find prints at most this many
+    static constexpr size_t MAX_LISTED_ERRORS = 10;    // export likewise
 }; 
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "ResourceExporter.h"
+#include "ResourceIndex.h"
+
+// Progress of a bulk PNG export running in the background
+class ExportWindow {
+public:
+    ~ExportWindow();
+
+    void Render(bool* open);
+
+    // Exports from a copy of the index, so the game can be closed while it runs.
+    // Returns false if an export is already running.
+    bool Start(const ResourceIndex& index, const std::string& directory);
+    void Cancel();
+    bool IsRunning() const { return running; }
+
+    // Called from Render once the export has finished
+    void SetOnFinished(std::function<void(const ExportResult&)> callback) { onFinished = callback; }
+
+private:
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::unique_ptr<ExportProgress> progress;
+    std::chrono::steady_clock::time_point startTime;
+    std::string outputDirectory;
+    std::function<void(const ExportResult&)> onFinished;
+
+    // Handed over from the worker under resultMutex
+    std::mutex resultMutex;
+    ExportResult pendingResult;
+    bool resultReady = false;
+
+    std::string summary;
+};
@@ -16,6 +16,8 @@ public:
     static std::string SaveFile(GLFWwindow* window, const std::string& title,
                                const std::vector<FileFilter>& filters = {});
 
+    static std::string SelectFolder(GLFWwindow* window, const std::string& title);
+
 private:
     static std::string GetFilterString(const std::vector<FileFilter>& filters);
 }; 
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BinaryFile.h"
+#include "Game.h"
+#include "ResourceLoader.h"
+
+// What FormatDetector found out about a game
+struct DetectedFormat {
+    GameFormat format = GameFormat::Unknown;
+    Endianness endian = Endianness::Big;
+    bool endianFromResources = false;   // Decided by the .res headers rather than the platform
+    std::string reason;                 // One line for the log
+    std::vector<ProbedResourceFile> resourceFiles;   // In the order they were passed to Detect
+};
+
+// Decides a game's platform and the byte order of its .res files from file
+// contents, so renamed files are still recognised and no .res file is parsed
+// with the wrong byte order.
+//
+// The platform comes from the executable's magic number (MZ, Amiga hunk, GEMDOS
+// PRG, IIGS OMF), falling back to the historical file names. Byte order comes
+// from probing each .res header with ResourceLoader::ProbeResourceHeader, with
+// the platform's order as the tie-break; the game takes the order most files use.
+class FormatDetector {
+public:
+    static DetectedFormat Detect(const std::string& gamePath, const std::vector<std::string>& resFiles);
+
+    // From the first EXECUTABLE_SAMPLE bytes; Unknown if no signature matches
+    static GameFormat FormatFromExecutable(const uint8_t* data, size_t size);
+    // The file names the original releases use
+    static GameFormat FormatFromName(const std::string& gamePath);
+    // Byte order each platform's data files use
+    static Endianness PlatformEndianness(GameFormat format);
+
+    static constexpr size_t EXECUTABLE_SAMPLE = 64;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+// Decides when the main loop draws. With power saving on, the loop sleeps in
+// glfwWaitEvents until there is input, and then draws a few frames so ImGui can
+// settle. Anything that changes on its own has to ask for frames:
+//   - animations call RequestContinuous() every frame while they play
+//   - progress displays call RequestRedrawIn() to tick at a modest rate
+//   - background threads call Wake() when their results are ready
+// Without any of these the editor draws nothing and uses no CPU or GPU.
+class FrameScheduler {
+public:
+    // Main thread, once per frame before drawing: polls or sleeps as needed
+    static void WaitForNextFrame();
+
+    static void SetPowerSaving(bool enable) { powerSaving = enable; }
+    static bool IsPowerSaving() { return powerSaving; }
+
+    // Main thread, during a frame; requests apply to the next wait only
+    static void RequestContinuous();
+    static void RequestRedrawIn(double seconds);
+
+    // Any thread: end the current wait now
+    static void Wake();
+
+    static constexpr int FRAMES_AFTER_EVENT = 3;       // Lets ImGui finish hover and layout changes
+    static constexpr double HOVER_FOLLOW_UP = 0.6;     // One more frame for delayed tooltips
+    static constexpr double TEXT_CURSOR_BLINK = 0.5;   // While a text field has focus
+    static constexpr double PROGRESS_INTERVAL = 0.1;   // Progress bars of background work
+
+private:
+    static bool powerSaving;
+    static bool continuous;
+    static double redrawAt;       // glfwGetTime() of the next timed redraw; < 0 means none
+    static int framesPending;
+};
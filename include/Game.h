@@ -3,9 +3,13 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <map>
 #include "FileFormat.h"
 #include "BinaryFile.h"
 #include "ResourceIndex.h"
+#include "ResourceLoader.h"
+#include "ResourceEdits.h"
+#include "ResourceFileWatcher.h"
 
 // Game format types
 enum class GameFormat {
@@ -16,6 +20,15 @@ enum class GameFormat {
     AtariST
 };
 
+// What Game::ReloadResourceFile changed. The reloaded file's entries are new
+// objects, so anything still holding an old one never sees it change.
+struct ResourceFileChanges {
+    // Old and new entry with the same type and number
+    std::vector<std::pair<std::shared_ptr<ResourceItem>, std::shared_ptr<ResourceItem>>> replaced;
+    std::vector<std::shared_ptr<ResourceItem>> removed;
+    std::vector<std::shared_ptr<ResourceItem>> added;
+};
+
 class Game {
 public:
     std::string Name;
@@ -30,13 +43,51 @@ public:
     bool LoadGame(const std::string& filePath);
     void UnloadGame();
     
+    // Byte order of this game's .res files
+    Endianness GetEndianness() const;
+    // Byte order resFile was loaded with; its header can overrule the game's
+    Endianness GetResourceFileEndianness(const std::string& resFile) const;
+    
+    // Writes edits back to their .res files. Saved edits are removed from edits and
+    // each saved file is reloaded, its changes added to reloaded; the old entries are
+    // left untouched for anyone still reading them. On failure the rest stay pending
+    // and error describes the first problem.
+    bool SaveEdits(ResourceEdits& edits, std::vector<std::pair<std::string, ResourceFileChanges>>& reloaded,
+                   std::string& error);
+    
+    // .res files the index was loaded from
+    const std::vector<std::string>& GetResourceFiles() const { return resourceFiles; }
+    
+    // Watches the .res files for rewrites by other programs. onChange is called from
+    // the watcher's thread; TakeChangedResourceFiles then lists the files.
+    bool WatchResourceFiles(std::function<void()> onChange, std::string& error);
+    std::vector<std::string> TakeChangedResourceFiles() { return watcher.TakeChanged(); }
+    
+    // Re-parses one .res file and swaps its entries in the index where the old ones
+    // were; entries from other files are left alone. On failure nothing changes.
+    bool ReloadResourceFile(const std::string& resFile, ResourceFileChanges& changes, std::string& error);
+    
     // Debug callback
     static void SetDebugCallback(std::function<void(const std::string&)> callback);
     
 private:
+    std::vector<std::string> resourceFiles;
+    Endianness endianness = Endianness::Big;
+    std::map<std::string, Endianness> fileEndianness;   // As probed when each file was loaded
+    ResourceFileWatcher watcher;
+    
     bool InitializeGameData(const std::string& filePath);
-    GameFormat DetectFormat(const std::string& filePath, BinaryFile& file);
-    void LoadRealResources(const std::string& gamePath);
+    // Also probes every .res header, once, into probed
+    GameFormat DetectFormat(const std::string& filePath, const std::vector<std::string>& resFiles,
+                            std::vector<ProbedResourceFile>& probed);
+    void LoadRealResources(const std::vector<ProbedResourceFile>& resFiles);
+    // .res files next to the game file
+    static std::vector<std::string> FindResourceFiles(const std::string& gamePath);
+    // Probes resFile's header, then loads it as LoadProbedResourceFile does
+    std::unique_ptr<ResourceIndex> LoadResourceFile(const std::string& resFile, Endianness endian);
+    // Parses resFile in the probed byte order, or reads it from the index cache when it
+    // has not changed since; the header is not read again
+    std::unique_ptr<ResourceIndex> LoadProbedResourceFile(const std::string& resFile, const ResourceHeaderProbe& probe);
     
     static std::function<void(const std::string&)> debugCallback;
 }; 
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <imgui.h>
+
+// RGBA8 OpenGL texture owned by the UI thread
+class GpuTexture {
+public:
+    GpuTexture() = default;
+    ~GpuTexture();
+
+    GpuTexture(const GpuTexture&) = delete;
+    GpuTexture& operator=(const GpuTexture&) = delete;
+    GpuTexture(GpuTexture&& other) noexcept;
+    GpuTexture& operator=(GpuTexture&& other) noexcept;
+
+    // Uploads width*height RGBA pixels (IM_COL32 layout); reallocates only when the size changes
+    void Upload(const uint32_t* pixels, int width, int height);
+    void Release();
+
+    bool IsValid() const { return textureID != 0; }
+    ImTextureID GetID() const { return (ImTextureID)(intptr_t)textureID; }
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+private:
+    unsigned int textureID = 0;
+    int width = 0;
+    int height = 0;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Virtualised hex/ASCII view over a whole buffer. Only visible lines are laid
+// out, and formatted lines are kept in a small direct-mapped cache so scrolling
+// reformats only the lines that come into view.
+class HexView {
+public:
+    static constexpr size_t BYTES_PER_LINE = 16;
+    static constexpr size_t LINE_CACHE_SIZE = 256;
+
+    HexView();
+
+    // Data must outlive the view or be replaced by another SetData call
+    void SetData(const std::vector<uint8_t>* data);
+    void Render(const char* id, float height = 0.0f);
+
+    void GoTo(size_t offset);
+    void Select(size_t offset, size_t length);
+    bool FindNext();
+
+private:
+    struct CachedLine {
+        size_t line = SIZE_MAX;
+        std::string text;
+    };
+
+    const std::vector<uint8_t>* data = nullptr;
+    std::vector<CachedLine> lineCache;
+
+    size_t selectionStart = 0;
+    size_t selectionLength = 0;
+    size_t pendingScrollLine = SIZE_MAX;
+
+    char gotoBuffer[16] = {};
+    char searchBuffer[128] = {};
+    bool searchHex = false;
+    bool searchIgnoreCase = true;
+    std::string searchStatus;
+
+    const std::string& GetLine(size_t line);
+    void FormatLine(size_t line, std::string& out) const;
+    bool BuildSearchPattern(std::vector<uint8_t>& pattern) const;
+    void RenderToolbar();
+    void HandleClick(size_t line, float mouseX, float lineStartX, float charWidth);
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class LogLevel : uint8_t {
+    Info,
+    Warning,
+    Error
+};
+
+// Fixed-capacity log of text lines. All text lives in one circular arena, so
+// appending never allocates once constructed; when the arena or the line table
+// is full the oldest lines are dropped. Multi-line messages are split so every
+// line has the same height when rendered. Not thread-safe.
+class LogBuffer {
+public:
+    struct Line {
+        std::string_view text;   // Valid until the next Append or Clear
+        LogLevel level;
+    };
+
+    explicit LogBuffer(size_t maxLines = DEFAULT_MAX_LINES, size_t arenaBytes = DEFAULT_ARENA_BYTES);
+
+    void Append(std::string_view text, LogLevel level = LogLevel::Info);
+    void Clear();
+
+    size_t Size() const { return count; }
+    // 0 is the oldest line still held
+    Line operator[](size_t index) const;
+    // Lines ever appended, including dropped ones; changes whenever a line is added
+    uint64_t GetTotalAppended() const { return totalAppended; }
+
+    static constexpr size_t DEFAULT_MAX_LINES = 20000;
+    static constexpr size_t DEFAULT_ARENA_BYTES = 2 * 1024 * 1024;
+    static constexpr size_t MAX_LINE_BYTES = 1024;   // Longer lines are cut
+
+private:
+    struct Record {
+        uint64_t start;   // Position in the arena's unbounded byte stream
+        uint32_t length;
+        LogLevel level;
+    };
+
+    std::vector<char> arena;
+    std::vector<Record> records;
+    size_t first = 0;     // Oldest record
+    size_t count = 0;
+    uint64_t end = 0;     // Stream position where the next line goes
+    uint64_t totalAppended = 0;
+
+    void AppendLine(std::string_view line, LogLevel level);
+};
+
+// Copies log lines to stdout and/or a file through one buffer that is written
+// out by Flush() or when it fills, instead of flushing every line.
+class LogMirror {
+public:
+    ~LogMirror();
+
+    void SetStdout(bool enable) { toStdout = enable; }
+    // Empty filename closes the file. Returns false if it cannot be opened.
+    bool SetFile(const std::string& filename);
+
+    void Write(std::string_view line);
+    void Flush();
+
+    static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+private:
+    bool toStdout = false;
+    std::FILE* file = nullptr;
+    std::string pending;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "LogBuffer.h"
+
+struct LogRecord {
+    LogLevel level = LogLevel::Info;
+    std::string source;    // e.g. "ResourceLoader"; empty for the editor itself
+    std::string message;
+    std::chrono::system_clock::time_point time;
+};
+
+// Multi-producer, single-consumer queue of log records. Push is lock-free and
+// may be called from any thread; Drain must only be called from one thread
+// (the UI thread, once per frame). Producers push onto an atomic list head and
+// the consumer takes the whole list in one exchange, so neither side ever waits.
+class LogQueue {
+public:
+    LogQueue() = default;
+    ~LogQueue();
+
+    LogQueue(const LogQueue&) = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+
+    void Push(LogLevel level, std::string source, std::string message);
+
+    // Records in the order they were pushed. Returns how many were drained.
+    size_t Drain(std::vector<LogRecord>& out);
+
+    // Records dropped since the last call because MAX_PENDING were already waiting
+    size_t TakeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+    // Called by Push when the queue goes from empty to non-empty, e.g. to wake the UI.
+    // Set before any producer starts.
+    void SetOnFirstPush(std::function<void()> callback) { onFirstPush = callback; }
+
+    static constexpr size_t MAX_PENDING = 100000;
+
+private:
+    struct Node {
+        LogRecord record;
+        Node* next = nullptr;
+    };
+
+    std::atomic<Node*> head{nullptr};   // Most recent first
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> dropped{0};
+    std::function<void()> onFirstPush;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <imgui.h>
+
+class GpuTexture;
+
+// Zoomable, pannable view onto a tile map. Only cells inside the visible
+// rectangle are submitted, so draw cost follows the window size, not the map size.
+class MapViewport {
+public:
+    static constexpr float MIN_ZOOM = 0.125f;
+    static constexpr float MAX_ZOOM = 16.0f;
+    static constexpr float ZOOM_STEP = 1.25f;
+
+    // Opens a child region filling the available space and handles wheel zoom / drag pan.
+    // Always pair with End().
+    void Begin(const char* id, float contentWidth, float contentHeight);
+    void End();
+
+    // Draw one textured quad per visible cell; cells index an atlas laid out atlasColumns wide
+    void DrawTiles(const GpuTexture& atlas, uint32_t atlasColumns, const uint8_t* cells,
+                   uint32_t gridWidth, uint32_t gridHeight, uint32_t tileSize);
+
+    // Visible cell range [x0,x1) x [y0,y1) for a grid of tileSize-pixel cells
+    void GetVisibleCells(uint32_t gridWidth, uint32_t gridHeight, uint32_t tileSize,
+                         uint32_t& x0, uint32_t& y0, uint32_t& x1, uint32_t& y1) const;
+    ImVec2 ContentToScreen(float x, float y) const;
+
+    float GetZoom() const { return zoom; }
+    void SetZoom(float newZoom);
+    void FitToView();
+    bool IsHovered() const { return hovered; }
+    ImVec2 GetHoveredContentPos() const { return hoverContentPos; }
+
+private:
+    float zoom = 1.0f;
+    ImVec2 pan = ImVec2(0, 0);          // Content pixel at the top-left of the view
+    ImVec2 origin = ImVec2(0, 0);       // Screen position of the view
+    ImVec2 viewSize = ImVec2(0, 0);
+    ImVec2 contentSize = ImVec2(0, 0);
+    ImVec2 hoverContentPos = ImVec2(0, 0);
+    bool hovered = false;
+    bool fitPending = true;
+
+    void ZoomAround(float newZoom, ImVec2 screenAnchor);
+    void ClampPan();
+};
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ResourceDecoders.h"
+
+// Minimal PNG encoder for indexed images (colour type 3, 8 bits per pixel).
+// Uses zlib when the build found it (WIME_HAVE_ZLIB); otherwise the image data
+// is written as stored (uncompressed) deflate blocks, which every decoder reads.
+class PngWriter {
+public:
+    // palette: RGBA colours packed as in ResourceDecoders::GetPalette (alpha is ignored).
+    // compressionLevel: zlib level 0-9; low levels trade file size for speed.
+    static std::vector<uint8_t> EncodeIndexed(const IndexedImage& image, const uint32_t* palette, size_t paletteSize,
+                                              int compressionLevel = FAST_COMPRESSION);
+
+    // Encodes and writes the file; returns false and sets error on failure
+    static bool WriteIndexed(const std::string& filename, const IndexedImage& image, const uint32_t* palette,
+                             size_t paletteSize, int compressionLevel, std::string& error);
+
+    static uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0);
+
+    static constexpr int FAST_COMPRESSION = 1;
+    static constexpr size_t MAX_PALETTE_SIZE = 256;
+};
@@ -11,6 +11,11 @@ public:
     ~PreviewWindow();
 
     void SetResource(const std::shared_ptr<ResourceItem>& resource, const std::string& gameFilePath);
+    void SetResourceIndex(const ResourceIndex* index) { resourceIndex = index; }
+    void SetResourceEdits(ResourceEdits* edits) { resourceEdits = edits; }
+    // Drops cached data so the viewer re-reads the resource from disk
+    void Refresh();
+    void GoToOffset(size_t offset, size_t length);
     void Render();
     bool IsOpen() const { return isOpen; }
     void Close() { isOpen = false; }
@@ -19,6 +24,8 @@ public:
 private:
     std::shared_ptr<ResourceItem> resource;
     std::string gameFilePath;
+    const ResourceIndex* resourceIndex = nullptr;
+    ResourceEdits* resourceEdits = nullptr;
     std::unique_ptr<ResourceViewer> viewer;
     bool isOpen = true;
 
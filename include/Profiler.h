@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frame and scope timings for the profiler overlay.
+//
+// Timers only record while the profiler is enabled (the overlay is open); when
+// disabled a ScopedTimer costs one relaxed atomic load. Recorded scopes go into
+// a fixed-size ring buffer, so memory stays bounded however long it runs, and
+// statistics are computed from the ring only when asked for. Safe to record from
+// any thread.
+class Profiler {
+public:
+    struct ScopeStats {
+        std::string name;
+        double averageMs = 0.0;    // Per frame the scope ran in, summed over its calls
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+        double callsPerFrame = 0.0;
+        size_t frames = 0;         // Frames in the window the scope ran in
+    };
+
+    static void SetEnabled(bool enable);
+    static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    // Bracket one iteration of the main loop
+    static void BeginFrame();
+    static void EndFrame();
+
+    // Nanoseconds on the profiler clock; never 0
+    static uint64_t Now();
+    // name must outlive the profiler, e.g. a string literal
+    static void Record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Durations of the recorded frames in milliseconds, oldest first
+    static std::vector<float> GetFrameTimes();
+    // One entry per scope over the frames still in the ring, slowest average first
+    static std::vector<ScopeStats> GetScopeStats();
+    static void Clear();
+
+    // Everything in the ring as a Chrome trace (chrome://tracing, Perfetto)
+    static bool WriteChromeTrace(const std::string& filename, std::string& error);
+
+    static constexpr size_t EVENT_CAPACITY = 1 << 16;
+    static constexpr size_t FRAME_CAPACITY = 300;
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+// Times its own lifetime under `name` while the profiler is enabled
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const char* name)
+        : name(name), start(Profiler::IsEnabled() ? Profiler::Now() : 0) {}
+    ~ScopedTimer() {
+        if (start) Profiler::Record(name, start, Profiler::Now());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
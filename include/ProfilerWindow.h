@@ -0,0 +1,27 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Profiler.h"
+
+// Frame graph and per-scope timings. The profiler only records while this
+// window is open and not paused.
+class ProfilerWindow {
+public:
+    void Render(bool* open);
+
+    // Called when the user asks to save a Chrome trace
+    void SetOnSaveTrace(std::function<void()> callback) { onSaveTrace = callback; }
+
+private:
+    bool paused = false;
+    std::function<void()> onSaveTrace;
+
+    // Statistics are recomputed a few times a second rather than every frame
+    std::vector<float> frameTimes;
+    std::vector<Profiler::ScopeStats> scopeStats;
+    std::chrono::steady_clock::time_point lastRefresh;
+
+    static constexpr std::chrono::milliseconds REFRESH_INTERVAL{250};
+};
@@ -16,13 +16,16 @@ public:
     void Render();
     void SetSelectedResource(const std::shared_ptr<ResourceItem>& resource);
     void SetGameFilePath(const std::string& filePath);
+    void SetResourceIndex(const ResourceIndex* index);
     void ClearSelection();
+    void Refresh();
     
     
 private:
     std::shared_ptr<ResourceItem> selectedResource;
     bool hasSelection;
     std::string gameFilePath;
+    const ResourceIndex* resourceIndex = nullptr;
     
     // Current resource viewer
     std::unique_ptr<ResourceViewer> currentViewer;
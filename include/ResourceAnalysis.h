@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "MappedFile.h"
+#include "ResourceIndex.h"
+
+// Byte-value statistics for a block of resource data
+struct ByteStatistics {
+    std::array<uint64_t, 256> histogram{};   // 64-bit: stats adds up whole multi-GB games
+    size_t totalBytes = 0;
+    size_t uniqueValues = 0;
+    uint8_t modeValue = 0;      // Most frequent byte value (lowest value on ties)
+    uint64_t modeCount = 0;
+    double entropy = 0.0;       // Shannon entropy in bits per byte (0..8)
+};
+
+// Sizes and content of all chunks of one resource type
+struct TypeStatistics {
+    size_t count = 0;
+    uint64_t bytes = 0;         // Sum of the key table sizes
+    uint32_t smallest = UINT32_MAX;
+    uint32_t largest = 0;
+    ByteStatistics content;     // Over the chunks as stored, length words included
+};
+
+// Items handled so far by ComputeTypeStatistics; setting cancel stops it
+struct AnalysisProgress {
+    std::atomic<size_t> itemsDone{0};
+    std::atomic<bool> cancel{false};
+};
+
+class ResourceAnalysis {
+public:
+    // 256-bin histogram of data, added into histogram
+    static void ComputeHistogram(const uint8_t* data, size_t size, uint64_t* histogram);
+    static ByteStatistics AnalyzeBytes(const uint8_t* data, size_t size);
+    // Fills the derived fields from histogram and totalBytes, e.g. after accumulating several blocks
+    static void Summarize(ByteStatistics& stats);
+
+    // The `count` most frequent values, most frequent first; zero-count values are skipped
+    static std::vector<std::pair<uint8_t, uint64_t>> TopValues(const ByteStatistics& stats, size_t count);
+
+    // One read-only mapping per .res file the items come from; files that cannot be
+    // mapped are left out and their errors appended to errors
+    static std::map<std::string, std::unique_ptr<MappedFile>> MapSourceFiles(const std::vector<std::shared_ptr<ResourceItem>>& items,
+                                                                              std::vector<std::string>& errors);
+    // The chunk including its length word, clipped to the file
+    static bool ChunkBytes(const MappedFile& file, const ResourceItem& item, const uint8_t*& data, size_t& size);
+    // Statistics per type ID, content summarized, reading chunks through files.
+    // Returns false, with byType incomplete, when progress->cancel is set.
+    static bool ComputeTypeStatistics(const std::vector<std::shared_ptr<ResourceItem>>& items,
+                                      const std::map<std::string, std::unique_ptr<MappedFile>>& files,
+                                      std::map<std::string, TypeStatistics>& byType,
+                                      AnalysisProgress* progress = nullptr);
+
+    // Bytes counted in 32-bit sub-histograms before they are added into the 64-bit bins
+    static constexpr size_t HISTOGRAM_BLOCK = size_t(1) << 30;
+
+    // Statistics computed once per resource and reused across frames and viewers.
+    // `kind` distinguishes different views of the same resource (raw chunk, decoded cells, ...).
+    static std::shared_ptr<const ByteStatistics> GetCached(const ResourceItem& item, const char* kind,
+                                                           const std::vector<uint8_t>& data);
+    static void ClearCache();
+    // Statistics of one .res file's resources only
+    static void ClearCache(const std::string& sourceFile);
+
+private:
+    static std::unordered_map<std::string, std::shared_ptr<const ByteStatistics>> cache;
+};
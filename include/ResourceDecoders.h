@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ResourceIndex.h"
+
+// Image of palette indices, one byte per pixel
+struct IndexedImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+// Decoded MMAP chunk: one tile number per grid cell
+struct MapCells {
+    uint32_t gridWidth = 0;
+    uint32_t gridHeight = 0;
+    bool headerRecognised = false;  // false: the default grid was used
+    std::vector<uint8_t> cells;
+};
+
+// Pure resource decoders: file bytes in, plain buffers out. No UI or GPU dependencies,
+// so the editor, the CLI and the exporter share them.
+class ResourceDecoders {
+public:
+    static constexpr uint32_t TILE_SIZE = 16;
+    static constexpr uint32_t TILE_COUNT = 256;
+    static constexpr uint32_t TILE_BYTES = 128;  // 16x16 pixels, 4bpp = 2 pixels per byte
+    static constexpr uint32_t ATLAS_COLUMNS = 16;
+    static constexpr uint32_t ATLAS_SIZE = ATLAS_COLUMNS * TILE_SIZE;
+
+    static constexpr uint32_t MAP_HEADER_BYTES = 8;        // chunk size + grid width + grid height
+    static constexpr uint32_t MAP_CHUNK_OVERHEAD = 18;     // header plus trailer not part of the ByteRun stream
+    static constexpr uint32_t MAX_GRID_DIMENSION = 4096;
+    static constexpr uint32_t MAX_BYTERUN_EXPANSION = 64;  // A 2-byte repeat run yields at most 128 bytes
+    static constexpr uint32_t DEFAULT_GRID_WIDTH = 160;    // Used when the header is not recognised
+    static constexpr uint32_t DEFAULT_GRID_HEIGHT = 99;
+
+    static constexpr uint32_t PALETTE_SIZE = 32;
+
+    // RGBA colour for a palette index, packed as R | G << 8 | B << 16 | A << 24
+    // (the layout of GL_RGBA bytes on little-endian hosts). Indices 16+ are opaque black.
+    static uint32_t GetPaletteColor(uint8_t index);
+    static const std::array<uint32_t, PALETTE_SIZE>& GetPalette();
+    // Palette lookup of every pixel, e.g. for a texture upload
+    static void ExpandPalette(const IndexedImage& image, std::vector<uint32_t>& rgba);
+
+    // CHAR: raw 4bpp tile data following the chunk length (up to TILE_COUNT * TILE_BYTES bytes)
+    static std::vector<uint8_t> ReadTileData(const std::string& sourceFile, uint32_t offset);
+    // Palette indices of one 16x16 tile into out[TILE_SIZE * TILE_SIZE]; zero if the tile is missing
+    static void DecodeTile(const std::vector<uint8_t>& tileData, size_t tileIndex, uint8_t* out);
+    // All tiles laid out ATLAS_COLUMNS per row
+    static IndexedImage BuildTileAtlas(const std::vector<uint8_t>& tileData);
+
+    // MMAP: grid size from the header, cells from the ByteRun stream. chunk holds the header
+    // and the whole stream, which bounds the grid size either byte order may claim.
+    static bool ParseMapHeader(const std::vector<uint8_t>& chunk, MapCells& map);
+    static bool ReadMap(const ResourceItem& item, MapCells& map);
+    // ByteRun (PackBits) decode; returns the number of bytes written. Unfilled output is left untouched.
+    static size_t DecodeByteRun(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+    // Blits each cell's tile from the atlas into a gridWidth*16 x gridHeight*16 image
+    static IndexedImage ComposeMap(const MapCells& map, const IndexedImage& atlas);
+
+    // Interleaved bitplanes: each row holds one word-aligned line per plane
+    static size_t PlanarImageBytes(uint32_t width, uint32_t height, uint32_t planes);
+    static bool DecodePlanar(const uint8_t* data, size_t size, uint32_t width, uint32_t height,
+                             uint32_t planes, IndexedImage& image);
+    // IMAG: a width/height header after the chunk length, then planar data
+    static bool ReadImage(const ResourceItem& item, uint32_t planes, IndexedImage& image);
+    static constexpr uint32_t IMAGE_HEADER_BYTES = 8;     // chunk size + width + height
+    static constexpr uint32_t MAX_IMAGE_DIMENSION = 1024;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ResourceIndex.h"
+
+// New payload for a resource chunk (the bytes after its 4-byte length)
+struct ResourceEdit {
+    std::shared_ptr<ResourceItem> item;
+    std::vector<uint8_t> payload;
+};
+
+// Unsaved edits, at most one per resource
+class ResourceEdits {
+public:
+    void Set(const std::shared_ptr<ResourceItem>& item, std::vector<uint8_t> payload) {
+        edits[item.get()] = ResourceEdit{item, std::move(payload)};
+    }
+
+    void Discard(const ResourceItem& item) {
+        edits.erase(&item);
+    }
+
+    const ResourceEdit* Find(const ResourceItem& item) const {
+        auto found = edits.find(&item);
+        return found != edits.end() ? &found->second : nullptr;
+    }
+
+    bool HasEdits() const { return !edits.empty(); }
+    size_t Count() const { return edits.size(); }
+    void Clear() { edits.clear(); }
+
+    // Edits grouped by the .res file they belong to
+    std::map<std::string, std::vector<ResourceEdit>> GetEditsByFile() const {
+        std::map<std::string, std::vector<ResourceEdit>> byFile;
+        for (const auto& entry : edits) {
+            byFile[entry.second.item->sourceFile].push_back(entry.second);
+        }
+        return byFile;
+    }
+
+private:
+    std::unordered_map<const ResourceItem*, ResourceEdit> edits;
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ResourceIndex.h"
+
+struct ExportOptions {
+    std::string outputDirectory;
+    std::vector<ResourceType> types;  // Empty means every image type (CHAR, IMAG, MMAP)
+    unsigned threads = 0;             // 0 means hardware concurrency
+    int compressionLevel = 1;         // zlib level; 1 keeps encoding well ahead of the disk
+    uint32_t imagePlanes = 4;         // Bitplanes assumed for IMAG data
+};
+
+// Updated by the workers while an export runs; safe to read from another thread
+struct ExportProgress {
+    std::atomic<size_t> total{0};
+    std::atomic<size_t> done{0};      // Finished, whether exported, skipped or failed
+    std::atomic<size_t> failed{0};
+    std::atomic<size_t> skipped{0};   // Maps without a tileset, images with no usable header
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<bool> cancel{false};
+};
+
+struct ExportResult {
+    size_t exported = 0;
+    size_t failed = 0;
+    size_t skipped = 0;
+    uint64_t bytesWritten = 0;
+    double seconds = 0.0;
+    bool cancelled = false;
+    std::vector<std::string> errors;  // First MAX_REPORTED_ERRORS messages
+};
+
+// Bulk PNG export of every map, tileset and image in a game.
+//
+// Each resource is one task on a work-stealing pool; tasks decode, compose and
+// encode independently and write their own file, so output is written
+// concurrently. Tilesets are decoded once and shared by every map that uses them.
+// Files go to <outputDirectory>/<res-file>/<TYPE>_<number>.png.
+class ResourceExporter {
+public:
+    static ExportResult ExportImages(const ResourceIndex& index, const ExportOptions& options, ExportProgress& progress);
+
+    static bool IsImageType(ResourceType type) {
+        return type == ResourceType::CHAR || type == ResourceType::IMAG || type == ResourceType::MMAP;
+    }
+
+    static constexpr size_t MAX_REPORTED_ERRORS = 100;
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Watches a set of files for changes made by other programs.
+//
+// On Linux the directories holding the files are watched with inotify, so a file
+// that is rewritten in place or replaced by a rename is seen either way; other
+// platforms poll sizes and modification times. A change is reported once the
+// file has been quiet for SETTLE_TIME, so a writer's several writes are one change.
+class ResourceFileWatcher {
+public:
+    ResourceFileWatcher() = default;
+    ~ResourceFileWatcher();
+
+    ResourceFileWatcher(const ResourceFileWatcher&) = delete;
+    ResourceFileWatcher& operator=(const ResourceFileWatcher&) = delete;
+
+    // Replaces any previous watch. onChange is called from the watcher's thread
+    // whenever changed files are ready for TakeChanged.
+    bool Start(const std::vector<std::string>& files, std::function<void()> onChange, std::string& error);
+    void Stop();
+    bool IsWatching() const { return worker.joinable(); }
+
+    // Files that changed since the last call, spelled as they were passed to Start
+    std::vector<std::string> TakeChanged();
+
+    static constexpr std::chrono::milliseconds SETTLE_TIME{250};
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{1000};   // Where inotify is unavailable
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::string> files;
+    std::function<void()> onChange;
+    std::thread worker;
+    std::atomic<bool> stopping{false};
+
+    std::mutex mutex;                     // Guards ready
+    std::vector<std::string> ready;
+    std::map<std::string, Clock::time_point> pending;   // Worker only: file -> last change
+
+#ifdef __linux__
+    int inotifyFd = -1;
+    int wakeFds[2] = {-1, -1};            // Pipe that interrupts the worker's poll on Stop
+    std::map<int, std::filesystem::path> directories;     // Watch descriptor -> directory
+    std::map<std::filesystem::path, std::string> byPath;  // Absolute path -> name as passed to Start
+#else
+    struct Stamp {
+        uintmax_t size = 0;
+        std::filesystem::file_time_type modified;
+    };
+    std::map<std::string, Stamp> stamps;  // Worker only
+    std::mutex stopMutex;
+    std::condition_variable stopSignal;
+#endif
+
+    void Run();
+    // Moves files quiet for SETTLE_TIME to ready; returns time until the next one settles
+    Clock::duration Settle();
+};
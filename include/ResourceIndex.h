@@ -14,15 +14,41 @@ enum class ResourceType {
     ARCHIVE // Archive
 };
 
+// Four-character chunk ID as stored in .res files ("CSTR", "MMAP", ...)
+inline const char* GetResourceTypeID(ResourceType type) {
+    switch (type) {
+        case ResourceType::CHAR: return "CHAR";
+        case ResourceType::CSTR: return "CSTR";
+        case ResourceType::FONT: return "FONT";
+        case ResourceType::FRML: return "FRML";
+        case ResourceType::IMAG: return "IMAG";
+        case ResourceType::MMAP: return "MMAP";
+        default: return "????";
+    }
+}
+
+// Inverse of GetResourceTypeID; false for unknown IDs
+inline bool ParseResourceTypeID(const std::string& id, ResourceType& type) {
+    for (ResourceType candidate : {ResourceType::CHAR, ResourceType::CSTR, ResourceType::FONT,
+                                   ResourceType::FRML, ResourceType::IMAG, ResourceType::MMAP}) {
+        if (id == GetResourceTypeID(candidate)) {
+            type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
 struct ResourceItem {
     std::string name;
     uint32_t offset;
     uint32_t size;
     ResourceType type;
     std::string sourceFile;  // The .res file this resource comes from
+    uint16_t number;         // Resource number from the key table
     
-    ResourceItem(const std::string& n = "", uint32_t off = 0, uint32_t sz = 0, ResourceType t = ResourceType::CHAR, const std::string& file = "")
-        : name(n), offset(off), size(sz), type(t), sourceFile(file) {}
+    ResourceItem(const std::string& n = "", uint32_t off = 0, uint32_t sz = 0, ResourceType t = ResourceType::CHAR, const std::string& file = "", uint16_t num = 0)
+        : name(n), offset(off), size(sz), type(t), sourceFile(file), number(num) {}
 };
 
 class ResourceIndex {
@@ -33,8 +59,8 @@ public:
     ResourceIndex() = default;
     ResourceIndex(const std::string& id) : ID(id) {}
     
-    void AddItem(const std::string& name, uint32_t offset, uint32_t size, ResourceType type, const std::string& sourceFile = "") {
-        items.emplace_back(std::make_shared<ResourceItem>(name, offset, size, type, sourceFile));
+    void AddItem(const std::string& name, uint32_t offset, uint32_t size, ResourceType type, const std::string& sourceFile = "", uint16_t number = 0) {
+        items.emplace_back(std::make_shared<ResourceItem>(name, offset, size, type, sourceFile, number));
     }
     
     std::vector<std::shared_ptr<ResourceItem>> GetItemsByType(ResourceType type) const {
@@ -47,6 +73,18 @@ public:
         return result;
     }
     
+    // Tileset for a map: a CHAR chunk from the same .res file, preferring the one with the
+    // same resource number, otherwise the first CHAR in that file
+    std::shared_ptr<ResourceItem> FindTilesetFor(const ResourceItem& map) const {
+        std::shared_ptr<ResourceItem> firstInFile;
+        for (const auto& item : items) {
+            if (item->type != ResourceType::CHAR || item->sourceFile != map.sourceFile) continue;
+            if (item->number == map.number) return item;
+            if (!firstInFile) firstInFile = item;
+        }
+        return firstInFile;
+    }
+    
     size_t GetItemCount(ResourceType type) const {
         size_t count = 0;
         for (const auto& item : items) {
@@ -15,6 +15,32 @@ struct ResourceHeader {
     uint32_t fileEndLength;
 };
 
+// Why a file was rejected before any of it was parsed
+enum class ResourceHeaderError {
+    None,
+    CannotOpen,
+    TooSmall,               // Shorter than a header plus the trailer's type count
+    BadHeaderSize,          // Header size below 16 bytes or past the end of the file
+    TrailerOutOfRange,      // Header plus data segment points past the end of the file
+    TypeTableOutOfRange     // The type identifiers run past the end of the file
+};
+
+// A header that passed ProbeResourceHeader, with where the tables behind it start
+struct ResourceHeaderProbe {
+    ResourceHeader header{};
+    Endianness endian = Endianness::Big;
+    uint32_t trailer = 0;       // header.size + header.dataSegmentSize
+    uint16_t typeCount = 0;
+    uint32_t keyPosition = 0;   // First 12-byte key entry, after the type identifiers
+};
+
+// A .res file's header as probed before loading, e.g. during format detection
+struct ProbedResourceFile {
+    std::string path;
+    ResourceHeaderError error = ResourceHeaderError::None;
+    ResourceHeaderProbe probe;          // Valid when error is None
+};
+
 // Resource map entry structure
 struct ResourceMap {
     uint16_t number;      // 2 bytes - matches VB.NET ReadWordUnsigned
@@ -30,7 +56,24 @@ struct ResourceIdentifier {
 
 class ResourceLoader {
 public:
+    // endian is the expected byte order; the header decides when only the other one fits the file
     static std::unique_ptr<ResourceIndex> LoadResourceFile(const std::string& filename, Endianness endian);
+    // For a file already probed: parses it in probe.endian without reading the header again
+    static std::unique_ptr<ResourceIndex> LoadResourceFile(const std::string& filename, const ResourceHeaderProbe& probe);
+
+    // Reads the 16-byte header once and picks the byte order whose sizes fit the file.
+    // When both do, the order whose size fields agree and whose first type ID is known
+    // wins, then `preferred`. Then checks the type table fits. This is the one rule for
+    // a file's byte order; FormatDetector uses it too.
+    static ResourceHeaderError ProbeResourceHeader(BinaryFile& file, Endianness preferred, ResourceHeaderProbe& probe);
+    static ResourceHeader DecodeResourceHeader(const uint8_t* bytes, Endianness endian);
+    // The invariants of one decoded header against the file length
+    static ResourceHeaderError CheckResourceHeader(const ResourceHeader& header, uint64_t fileLength);
+    static const char* DescribeHeaderError(ResourceHeaderError error);
+
+    static constexpr uint32_t HEADER_BYTES = 16;
+    static constexpr uint32_t TYPE_COUNT_OFFSET = 12;   // From the trailer
+    static constexpr int KNOWN_TYPE_POINTS = 3;          // Tie-break weight of a recognised first type ID
     
     // Debug callback
     static void SetDebugCallback(std::function<void(const std::string&)> callback);
@@ -38,11 +81,12 @@ public:
 private:
     static std::function<void(const std::string&)> debugCallback;
     
+    static std::unique_ptr<ResourceIndex> ParseResourceFile(BinaryFile& file, const std::string& filename,
+                                                            const ResourceHeaderProbe& probe);
+    
 private:
-    static ResourceHeader ReadResourceHeader(BinaryFile& file, Endianness endian);
     static std::vector<ResourceIdentifier> ReadResourceIdentifiers(BinaryFile& file, uint32_t startPos, uint16_t count, Endianness endian);
     static std::vector<ResourceMap> ReadResourceMaps(BinaryFile& file, uint32_t keyPosition, uint16_t count, Endianness endian);
-    static uint32_t GetResourceKeyPosition(BinaryFile& file, Endianness endian);
     static std::string GetChunkID(BinaryFile& file, uint32_t offset, Endianness endian);
     static uint16_t GetChunkQTY(BinaryFile& file, uint32_t offset, Endianness endian);
     static uint16_t ReadResMapNum(BinaryFile& file, uint32_t offset, Endianness endian);
@@ -50,5 +94,4 @@ private:
     static uint8_t ReadResMapMultiplier(BinaryFile& file, uint32_t offset, Endianness endian);
     static uint32_t GetChunkSize(BinaryFile& file, uint32_t offset, Endianness endian);
     static ResourceType GetResourceType(const std::string& resourceID);
-    static bool ValidateResourceHeader(const std::string& filename, Endianness endian);
 }; 
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ResourceIndex.h"
+
+// A match inside a resource; offset is relative to the start of the resource chunk
+struct SearchHit {
+    std::shared_ptr<ResourceItem> item;
+    uint32_t offset;
+};
+
+struct SearchQuery {
+    std::vector<uint8_t> pattern;
+    bool ignoreCase = false;     // ASCII letters only
+    size_t maxHits = 10000;
+};
+
+// Shared with the UI while a search runs on another thread
+struct SearchProgress {
+    std::atomic<uint64_t> bytesScanned{0};
+    std::atomic<uint64_t> bytesTotal{0};
+    std::atomic<bool> cancel{false};
+};
+
+class ResourceSearch {
+public:
+    // "DE AD be ef" -> {0xDE, 0xAD, 0xBE, 0xEF}; false on odd digit counts or non-hex characters
+    static bool ParseHexPattern(const std::string& text, std::vector<uint8_t>& pattern);
+
+    // Searches every .res file the items come from. Files are memory-mapped and
+    // scanned in parallel; hits outside any resource chunk (headers, key tables) are dropped.
+    static std::vector<SearchHit> Search(const std::vector<std::shared_ptr<ResourceItem>>& items,
+                                         const SearchQuery& query, SearchProgress* progress = nullptr);
+
+    // All match positions of pattern in [data, data+size), appended to hits in ascending order
+    static void FindAll(const uint8_t* data, size_t size, const std::vector<uint8_t>& pattern,
+                        bool ignoreCase, std::vector<size_t>& hits, size_t maxHits = SIZE_MAX);
+
+    static constexpr size_t CHUNK_BYTES = 4 * 1024 * 1024;  // Unit of work per thread
+};
@@ -1,9 +1,18 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "ResourceIndex.h"
+#include "ResourceEdits.h"
+#include "ResourceAnalysis.h"
+#include "ResourceDecoders.h"
+#include "AnimationPlayer.h"
+#include "GpuTexture.h"
+#include "MapViewport.h"
+#include "HexView.h"
 #include <imgui.h>
 
 // Forward declarations
@@ -18,17 +27,42 @@ public:
     virtual void SetResource(const std::shared_ptr<ResourceItem>& resource) = 0;
     virtual void SetGameFilePath(const std::string& filePath) = 0;
     virtual void ClearCache() = 0;
+    // Index of the loaded game, for viewers that resolve related resources
+    virtual void SetResourceIndex(const ResourceIndex* index) { (void)index; }
+    // Store of unsaved edits, for viewers that can modify their resource
+    virtual void SetResourceEdits(ResourceEdits* edits) { (void)edits; }
+    // Bring a byte range of the resource into view, for viewers that show raw data
+    virtual void GoToOffset(size_t offset, size_t length) { (void)offset; (void)length; }
 };
 
 // String resource viewer (CSTR)
 class StringResourceViewer : public ResourceViewer {
+public:
+    using EditCallback = std::function<void(const std::shared_ptr<ResourceItem>&, const std::string&)>;
+
 private:
     std::shared_ptr<ResourceItem> resource;
     std::string gameFilePath;
     std::string cachedData;
+    std::string loadError;
     bool dataLoaded = false;
 
-    std::string LoadStringData();
+    // Edit model: filled once per selection, grown by ImGui through CallbackResize.
+    // ImGui treats editBuffer as a C string, so it only holds the text before the
+    // first NUL; the terminator and anything after it are kept as they were.
+    std::string editBuffer;
+    std::string editSuffix;
+    bool editInitialised = false;
+    bool dirty = false;
+    ResourceEdits* resourceEdits = nullptr;
+
+    static EditCallback editCallback;
+    void OnTextEdited();
+    void SplitEditText(const std::string& data);
+    std::string GetEditedPayload() const { return editBuffer + editSuffix; }
+
+    const std::string& LoadStringData();
+    static int ResizeEditBuffer(ImGuiInputTextCallbackData* data);
 
 public:
     void RenderProperties() override;
@@ -36,6 +70,14 @@ public:
     void SetResource(const std::shared_ptr<ResourceItem>& resource) override;
     void SetGameFilePath(const std::string& filePath) override;
     void ClearCache() override;
+    void SetResourceEdits(ResourceEdits* edits) override { resourceEdits = edits; }
+
+    bool IsDirty() const { return dirty; }
+    const std::string& GetEditedText() const { return editBuffer; }
+    void RevertEdits();
+
+    // Called with the new text whenever any string viewer's text is edited
+    static void SetEditCallback(EditCallback callback);
 };
 
 // Map resource viewer (MMAP)
@@ -43,28 +85,42 @@ class MapResourceViewer : public ResourceViewer {
 private:
     std::shared_ptr<ResourceItem> resource;
     std::string gameFilePath;
-    std::vector<uint8_t> cachedDecompressedData;
+    MapCells mapCells;
     bool dataLoaded = false;
     
-    // Map properties
-    uint32_t width = 2560;
-    uint32_t height = 1584;
-    uint16_t planes = 1;
-    uint32_t mapGridWidth = 160;
-    uint32_t mapGridHeight = 99;
-    static constexpr uint32_t TILE_SIZE = 16;
+    // Map properties, read from the chunk header by DecompressMapData
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mapGridWidth = 0;
+    uint32_t mapGridHeight = 0;
+    bool headerRecognised = false;
+    std::shared_ptr<const ByteStatistics> tileUsage;
+    static constexpr uint32_t TILE_SIZE = ResourceDecoders::TILE_SIZE;
     
-    // Cached rendered map image
-    static std::vector<ImU32> cachedMapImage;
-    static std::vector<uint8_t> lastMapData;
-    static std::vector<uint8_t> lastTileData;
-    static bool imageValid;
+    // Decoded tileset, shared by every viewer showing a map that uses it
+    struct Tileset {
+        std::shared_ptr<ResourceItem> source;  // CHAR resource the tiles came from
+        std::vector<uint32_t> atlas;           // RGBA, ATLAS_SIZE x ATLAS_SIZE
+    };
+    const ResourceIndex* resourceIndex = nullptr;
+    std::shared_ptr<const Tileset> tileset;
+    bool tilesetResolved = false;
     
-    std::vector<uint8_t> DecompressMapData();
+    // Map -> tileset pairing and decoded tilesets, keyed by "file@offset"
+    static std::unordered_map<std::string, std::shared_ptr<ResourceItem>> tilesetPairing;
+    static std::unordered_map<std::string, std::shared_ptr<const Tileset>> tilesetCache;
+    
+    // Tileset uploaded once as a texture atlas; the map is drawn as one quad per visible cell
+    GpuTexture tileAtlas;
+    MapViewport viewport;
+    
+    const Tileset* ResolveTileset();
+    const std::vector<uint8_t>& DecompressMapData();
     void RenderMapGrid();
     void RenderMapProperties();
-    void RenderMapWithTiles(const std::vector<uint8_t>& mapData, const std::vector<uint8_t>& tileData);
-    void RenderMapToImage(const std::vector<uint8_t>& mapData, const std::vector<uint8_t>& tileData);
+    void RenderTileUsage();
+    void RenderMapWithTiles(const std::vector<uint8_t>& mapData, const Tileset& tiles);
+    void RenderMapCells(const std::vector<uint8_t>& mapData);
 
 public:
     void RenderProperties() override;
@@ -72,47 +128,25 @@ public:
     void SetResource(const std::shared_ptr<ResourceItem>& resource) override;
     void SetGameFilePath(const std::string& filePath) override;
     void ClearCache() override;
+    void SetResourceIndex(const ResourceIndex* index) override;
+    
+    // Drop cached tilesets, e.g. when a game is unloaded
+    static void ClearTilesetCache();
+    // Only those from one .res file, after it was reloaded
+    static void ClearTilesetCache(const std::string& sourceFile);
 };
 
 class CharResourceViewer : public ResourceViewer {
 private:
     std::shared_ptr<ResourceItem> resource;
     std::string gameFilePath;
-    std::vector<uint8_t> cachedDecompressedData;
+    std::vector<uint8_t> cachedTileData;
     bool dataLoaded = false;
-    static constexpr uint32_t TILE_COUNT = 256;
-    static constexpr uint32_t TILE_SIZE = 16;
-    static constexpr uint32_t TILE_BYTES = 128; // 16x16 pixels, 4bpp = 2 pixels per byte
-
-    // PC VGA palette based on VB code hex colors using ImGui color conversion (swapped R/B)
-    static ImU32 GetPaletteColor(uint8_t index) {
-        static const char* hexColors[16] = {
-            "000000", // 0: Black
-            "5586FF", // 1: Blue (from VGATilePalette index 1)
-            "306510", // 2: Green (from VGATilePalette index 2)
-            "755555", // 3: Brown (from VGATilePalette index 3)
-            "EBAA86", // 4: Light orange (from VGATilePalette index 4)
-            "00FFFF", // 5: Cyan (from VGATilePalette index 5)
-            "204110", // 6: Dark green (from VGATilePalette index 6)
-            "659655", // 7: Light green (from VGATilePalette index 7)
-            "868686", // 8: Gray (from VGATilePalette index 8)
-            "86BAFF", // 9: Light blue (from VGATilePalette index 9)
-            "CB0041", // 10: Red (from VGATilePalette index 10)
-            "FFFFFF", // 11: White (from VGATilePalette index 11)
-            "DB75CB", // 12: Pink (from VGATilePalette index 12)
-            "65BA00", // 13: Bright green (from VGATilePalette index 13)
-            "EBEBBA", // 14: Light yellow (from VGATilePalette index 14)
-            "FFFFDB"  // 15: Very light yellow (from VGATilePalette index 15)
-        };
-        
-        if (index < 16) {
-            uint32_t r, g, b;
-            sscanf_s(hexColors[index], "%02x%02x%02x", &r, &g, &b);
-            // Swap red and green for ImGui
-            return IM_COL32(g, r, b, 255);
-        }
-        return IM_COL32(0, 0, 0, 255); // Black fallback
-    }
+    static constexpr uint32_t TILE_COUNT = ResourceDecoders::TILE_COUNT;
+    static constexpr uint32_t TILE_SIZE = ResourceDecoders::TILE_SIZE;
+    static constexpr uint32_t TILE_BYTES = ResourceDecoders::TILE_BYTES;
+
+    const std::vector<uint8_t>& LoadTileData();
 
 public:
     void SetResource(const std::shared_ptr<ResourceItem>& resource) override;
@@ -120,14 +154,42 @@ public:
     void ClearCache() override;
     void RenderProperties() override;
     void RenderPreview() override;
+};
 
-    // Static method to get tile data for use by other viewers
-    static std::vector<uint8_t> GetTileData(const std::string& sourceFile, uint32_t offset);
-    static std::vector<uint8_t> DecodeTile(const std::vector<uint8_t>& tileData, size_t tileIndex);
-    static ImU32 GetTileColor(uint8_t pixelValue);
-
+// Form/animation viewer (FRML)
+class FormResourceViewer : public ResourceViewer {
 private:
-    std::vector<uint8_t> DecompressTileData();
+    std::shared_ptr<ResourceItem> resource;
+    std::string gameFilePath;
+    std::shared_ptr<const std::vector<uint8_t>> cachedData;
+    bool dataLoaded = false;
+
+    // Frame geometry parsed from the chunk header
+    uint16_t frameCount = 0;
+    uint16_t frameWidth = 0;
+    uint16_t frameHeight = 0;
+    int bitplanes = DEFAULT_BITPLANES;
+    int displayScale = 4;
+    float playbackSpeed = 1.0f;
+    bool playbackStarted = false;
+    AnimationPlayer player;
+
+    static constexpr int DEFAULT_BITPLANES = 4;
+    static constexpr uint32_t HEADER_BYTES = 10;      // chunk size + frame count + width + height
+    static constexpr double NATIVE_TICK_RATE = 50.0;  // Game logic runs on the 50Hz vertical blank
+    static constexpr int TICKS_PER_FRAME = 5;         // Animations step every fifth tick
+
+    bool LoadFormData();
+    bool ParseFrameHeader(const std::vector<uint8_t>& data);
+    size_t GetFrameBytes() const;
+    void StartPlayback();
+
+public:
+    void RenderProperties() override;
+    void RenderPreview() override;
+    void SetResource(const std::shared_ptr<ResourceItem>& resource) override;
+    void SetGameFilePath(const std::string& filePath) override;
+    void ClearCache() override;
 };
 
 // Generic binary resource viewer (for other types)
@@ -137,9 +199,11 @@ private:
     std::string gameFilePath;
     std::vector<uint8_t> cachedData;
     bool dataLoaded = false;
+    std::shared_ptr<const ByteStatistics> statistics;
+    HexView hexView;
 
-    std::vector<uint8_t> LoadBinaryData();
-    void RenderHexDump(const std::vector<uint8_t>& data, size_t maxBytes = 64);
+    const std::vector<uint8_t>& LoadBinaryData();
+    const ByteStatistics* GetStatistics();
 
 public:
     void RenderProperties() override;
@@ -147,6 +211,7 @@ public:
     void SetResource(const std::shared_ptr<ResourceItem>& resource) override;
     void SetGameFilePath(const std::string& filePath) override;
     void ClearCache() override;
+    void GoToOffset(size_t offset, size_t length) override;
 };
 
 // Factory function to create appropriate viewer
@@ -0,0 +1,52 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "BinaryFile.h"
+#include "ResourceEdits.h"
+#include "ResourceIndex.h"
+
+// One chunk for ResourceWriter::BuildResourceFile
+struct ResourceChunk {
+    std::string typeID;            // Four-character chunk type, e.g. "MMAP"
+    uint16_t number = 0;           // Resource number in the key table
+    std::vector<uint8_t> payload;  // Chunk data without the 4-byte length
+};
+
+// Writes .res files: edited chunks back into an existing file, or a new
+// file from a list of chunks.
+//
+// Saving rebuilds the whole file in memory: chunks after an edit move, and
+// their key table entries (offset word plus the 65536 multiplier byte) and the
+// data segment size are patched. The result is written to a uniquely named
+// temporary file in the same directory, given the original's permissions,
+// synced and renamed over the original, so a crash leaves either the old or
+// the new file. This holds even when no chunk changes size.
+class ResourceWriter {
+public:
+    // The edited items are only read: other threads may hold them, so the caller
+    // swaps in fresh entries for the saved file afterwards. Returns false and sets
+    // error on failure, in which case the original file is untouched.
+    static bool SaveResourceFile(const std::string& filename, Endianness endian,
+                                 const std::vector<ResourceEdit>& edits, std::string& error);
+
+    // Lays out a complete .res file the way ResourceLoader reads it: header, data
+    // segment of length-prefixed chunks (word aligned), then the identifier list
+    // and key table. Chunks of one type are listed in the key table in the order
+    // their type first appears. Fails if a chunk lies beyond the 24-bit offset range
+    // or a type has more than 65536 chunks.
+    static bool BuildResourceFile(Endianness endian, const std::vector<ResourceChunk>& chunks,
+                                  std::vector<uint8_t>& out, std::string& error);
+    static bool WriteResourceFile(const std::string& filename, Endianness endian,
+                                  const std::vector<ResourceChunk>& chunks, std::string& error);
+
+    // ByteRun (PackBits) encode, the inverse of ResourceDecoders::DecodeByteRun.
+    // Repeats of three or more bytes become runs; everything else is literal.
+    static std::vector<uint8_t> EncodeByteRun(const uint8_t* data, size_t size);
+
+    static constexpr uint32_t HEADER_SIZE = 16;
+    static constexpr size_t TRAILER_PREFIX = 12;      // Bytes after the data segment before the type count
+    static constexpr size_t IDENTIFIER_SIZE = 8;
+    static constexpr size_t KEY_ENTRY_SIZE = 12;
+    static constexpr uint32_t MAX_RELATIVE_OFFSET = 0xFFFFFF;  // 16-bit offset + 8-bit multiplier
+};
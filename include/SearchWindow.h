@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Game.h"
+#include "ResourceSearch.h"
+#include "StringIndex.h"
+
+// Finds a hex pattern or text across every .res file of the loaded game,
+// or words in the decoded CSTR strings via the string index
+class SearchWindow {
+public:
+    SearchWindow();
+    ~SearchWindow();
+
+    void Render();
+    void SetGame(const Game* game);
+    void ClearGame();
+    void SetStringIndex(const StringIndex* index) { stringIndex = index; }
+
+    // Called with the resource and the match offset/length inside it
+    void SetOnHitSelected(std::function<void(const std::shared_ptr<ResourceItem>&, size_t, size_t)> callback);
+
+private:
+    const Game* currentGame;
+    bool hasGame;
+    std::function<void(const std::shared_ptr<ResourceItem>&, size_t, size_t)> onHitSelected;
+
+    char queryBuffer[128] = {};
+    bool queryIsHex = false;
+    bool ignoreCase = true;
+    std::string status;
+
+    // Background search; results are handed over under resultMutex
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::unique_ptr<SearchProgress> progress;
+    std::mutex resultMutex;
+    std::vector<SearchHit> pendingResults;
+    bool resultsReady = false;
+
+    std::vector<SearchHit> results;
+    size_t patternLength = 0;
+    int selectedHit = -1;
+
+    const StringIndex* stringIndex = nullptr;
+    char textQueryBuffer[128] = {};
+    std::vector<StringMatch> textResults;
+    bool textIndexWasBuilding = false;
+    int selectedTextHit = -1;
+
+    void StartSearch();
+    void CancelSearch();
+    void RenderByteSearch();
+    void RenderResults();
+    void RenderTextSearch();
+    void RunTextQuery();
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ResourceIndex.h"
+
+// A string resource matching a query; offset/length locate the first match in the text
+struct StringMatch {
+    std::shared_ptr<ResourceItem> item;
+    size_t offset;
+    size_t length;
+    std::string snippet;  // Surrounding text on one line, for result lists
+};
+
+// Inverted word index over the decoded text of every CSTR resource.
+// Words are runs of ASCII letters and digits, matched case-insensitively.
+// Query syntax: space-separated words must all occur; "quoted words" must occur
+// consecutively; a trailing * makes a word a prefix (drag* matches dragon).
+class StringIndex {
+public:
+    StringIndex() = default;
+    ~StringIndex();
+
+    StringIndex(const StringIndex&) = delete;
+    StringIndex& operator=(const StringIndex&) = delete;
+
+    // Decodes and indexes every CSTR in items on a background thread, replacing the current index
+    void BuildAsync(const std::vector<std::shared_ptr<ResourceItem>>& items);
+    void Clear();
+    bool IsBuilding() const { return building; }
+    size_t GetDocumentCount() const;
+
+    // Re-indexes one resource after its text has been edited
+    void Update(const std::shared_ptr<ResourceItem>& item, const std::string& text);
+    // After a .res file was reloaded: drops removed resources and reads and indexes added ones
+    void Replace(const std::vector<std::shared_ptr<ResourceItem>>& removed,
+                 const std::vector<std::shared_ptr<ResourceItem>>& added);
+
+    std::vector<StringMatch> Query(const std::string& query, size_t maxResults = 500) const;
+
+    // Text of a CSTR chunk as stored in the .res file; false if the file cannot be read
+    static bool ReadStringResource(const ResourceItem& item, std::string& text);
+
+private:
+    struct Posting {
+        uint32_t document;
+        uint32_t position;  // Word number within the document
+    };
+    struct Document {
+        std::shared_ptr<ResourceItem> item;
+        std::string text;
+        std::vector<uint32_t> wordOffsets;  // Character offset of each word
+        std::vector<uint32_t> wordLengths;
+    };
+    struct Data {
+        std::vector<Document> documents;
+        std::map<std::string, std::vector<Posting>> postings;  // Ordered for prefix lookups
+        std::unordered_map<const ResourceItem*, uint32_t> documentByItem;
+    };
+
+    mutable std::shared_mutex mutex;
+    Data data;
+    std::thread worker;
+    std::atomic<bool> building{false};
+    std::atomic<bool> cancel{false};
+    uint64_t generation = 0;  // Bumped by Clear/BuildAsync so stale builds are discarded
+    std::vector<std::pair<std::shared_ptr<ResourceItem>, std::string>> pendingUpdates;
+    std::vector<std::shared_ptr<ResourceItem>> pendingRemovals;   // Applied after pendingUpdates
+
+    void StopWorker();
+    static void AddDocument(Data& index, const std::shared_ptr<ResourceItem>& item, std::string text);
+    static void RemoveDocument(Data& index, uint32_t document);
+    static void RemoveItem(Data& index, const ResourceItem* item);
+    static std::vector<Posting> FindPhrase(const Data& index, const std::vector<std::string>& words, bool lastIsPrefix);
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size thread pool with one task deque per worker. Workers take their own
+// newest task first and steal the oldest task from another worker when idle, so a
+// few large tasks (big maps) do not leave the other threads waiting.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    // threadCount 0 means hardware concurrency
+    explicit WorkStealingPool(unsigned threadCount = 0);
+    // Finishes queued tasks, then joins the workers
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Called from a worker, the task goes to that worker's deque; otherwise round-robin
+    void Submit(Task task);
+    // Blocks until every submitted task has finished
+    void Wait();
+
+    unsigned GetThreadCount() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextQueue{0};
+    std::atomic<size_t> queued{0};   // Tasks waiting in any deque
+    std::atomic<size_t> pending{0};  // Tasks submitted but not finished
+    bool stopping = false;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable idleCondition;
+
+    void WorkerLoop(size_t index);
+    bool TryTake(size_t index, Task& task);
+};
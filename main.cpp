@@ -13,6 +13,8 @@
 #include "EditorSettings.h"
 #include "FileDialog.h"
 #include "EditorUI.h"
+#include "Profiler.h"
+#include "FrameScheduler.h"
 
 int main() {
 #ifdef _WIN32
@@ -76,7 +78,9 @@ int main() {
 
     // Main loop
     while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
+        // Sleeps until there is something to draw when power saving is on
+        FrameScheduler::WaitForNextFrame();
+        Profiler::BeginFrame();
 
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
@@ -99,24 +103,46 @@ int main() {
             }
             editorUI.ClearOpenFileFlag();
         }
+        
+        // Handle image export from menu
+        if (editorUI.ShouldExportImages()) {
+            std::string directory = FileDialog::SelectFolder(window, "Export Images To");
+            if (!directory.empty()) {
+                editorUI.OnExportImages(directory);
+            }
+            editorUI.ClearExportImagesFlag();
+        }
+        
+        // Handle trace saving from the profiler overlay
+        if (editorUI.ShouldSaveTrace()) {
+            std::string filePath = FileDialog::SaveFile(window, "Save Chrome Trace", {{"Chrome Trace", "*.json"}});
+            if (!filePath.empty()) {
+                editorUI.OnSaveTrace(filePath);
+            }
+            editorUI.ClearSaveTraceFlag();
+        }
 
-        ImGui::Render();
-        int display_w, display_h;
-        glfwGetFramebufferSize(window, &display_w, &display_h);
-        glViewport(0, 0, display_w, display_h);
-        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            ScopedTimer drawTimer("ImGui render + GL submit");
+            ImGui::Render();
+            int display_w, display_h;
+            glfwGetFramebufferSize(window, &display_w, &display_h);
+            glViewport(0, 0, display_w, display_h);
+            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         
-        // Update and Render additional Platform Windows
-        if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
-            GLFWwindow* backup_current_context = glfwGetCurrentContext();
-            ImGui::UpdatePlatformWindows();
-            ImGui::RenderPlatformWindowsDefault();
-            glfwMakeContextCurrent(backup_current_context);
+            // Update and Render additional Platform Windows
+            if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
+                GLFWwindow* backup_current_context = glfwGetCurrentContext();
+                ImGui::UpdatePlatformWindows();
+                ImGui::RenderPlatformWindowsDefault();
+                glfwMakeContextCurrent(backup_current_context);
+            }
         }
         
         glfwSwapBuffers(window);
+        Profiler::EndFrame();
     }
 
     // Cleanup
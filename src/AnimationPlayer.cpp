@@ -0,0 +1,136 @@
+#include "AnimationPlayer.h"
+#include "FrameScheduler.h"
+#include <algorithm>
+
+AnimationPlayer::~AnimationPlayer() {
+    Stop();
+}
+
+void AnimationPlayer::Start(size_t count, int frameWidth, int frameHeight, double duration, FrameDecoder frameDecoder) {
+    Stop();
+    if (count == 0 || frameWidth <= 0 || frameHeight <= 0 || !frameDecoder) return;
+
+    frameCount = count;
+    width = frameWidth;
+    height = frameHeight;
+    frameDuration = duration;
+    decoder = std::move(frameDecoder);
+    slots.resize(std::min(RING_SIZE, frameCount));
+
+    playhead = 0;
+    nextToDecode = 0;
+    accumulator = 0.0;
+    hasShownFrame = false;
+    droppedFrames = 0;
+    stopRequested = false;
+    worker = std::thread(&AnimationPlayer::WorkerLoop, this);
+}
+
+void AnimationPlayer::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wake.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    slots.clear();
+    decoder = nullptr;
+    frameCount = 0;
+}
+
+void AnimationPlayer::WorkerLoop() {
+    std::vector<uint32_t> scratch;
+    for (;;) {
+        uint64_t sequence;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            // Decode at most one ring ahead of what is on screen; the playhead's slot is never reused
+            wake.wait(lock, [this] { return stopRequested || nextToDecode < playhead + slots.size(); });
+            if (stopRequested) return;
+            sequence = nextToDecode++;
+
+            // Short animations fit the ring entirely: the slot already holds this frame
+            Slot& slot = SlotFor(sequence);
+            if (slots.size() == frameCount && slot.decoded) {
+                slot.sequence = sequence;
+                continue;
+            }
+        }
+
+        scratch.assign(static_cast<size_t>(width) * height, 0);
+        if (!decoder(static_cast<size_t>(sequence % frameCount), scratch)) {
+            std::fill(scratch.begin(), scratch.end(), 0u);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopRequested) return;
+        Slot& slot = SlotFor(sequence);
+        slot.sequence = sequence;
+        slot.pixels.swap(scratch);
+        slot.uploaded = false;
+        slot.decoded = true;
+    }
+}
+
+void AnimationPlayer::Update(double deltaTime) {
+    if (slots.empty()) return;
+    // Keep drawing while frames advance or the first one is still being decoded
+    if (playing || !hasShownFrame) FrameScheduler::RequestContinuous();
+
+    bool advanced = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Upload any slots the worker has finished since last frame
+        for (Slot& slot : slots) {
+            if (slot.decoded && !slot.uploaded) {
+                slot.texture.Upload(slot.pixels.data(), width, height);
+                slot.uploaded = true;
+            }
+        }
+
+        auto isReady = [this](uint64_t sequence) {
+            const Slot& slot = SlotFor(sequence);
+            return slot.uploaded && slot.sequence == sequence;
+        };
+
+        if (!hasShownFrame) {
+            hasShownFrame = isReady(playhead);
+            return;
+        }
+        if (!playing || frameCount < 2) return;
+
+        accumulator += deltaTime;
+        while (accumulator >= frameDuration) {
+            if (!isReady(playhead + 1)) {
+                // Worker is behind: hold the current frame rather than stall the UI
+                droppedFrames++;
+                accumulator = 0.0;
+                break;
+            }
+            accumulator -= frameDuration;
+            playhead++;
+            advanced = true;
+        }
+    }
+
+    if (advanced) {
+        wake.notify_one();
+    }
+}
+
+bool AnimationPlayer::HasFrame() const {
+    return !slots.empty() && hasShownFrame;
+}
+
+ImTextureID AnimationPlayer::GetTexture() const {
+    if (!HasFrame()) return ImTextureID{};
+    return SlotFor(playhead).texture.GetID();
+}
+
+size_t AnimationPlayer::GetCurrentFrame() const {
+    if (frameCount == 0) return 0;
+    return static_cast<size_t>(playhead % frameCount);
+}
@@ -3,8 +3,12 @@
 #include <iomanip>
 #include <sstream>
 
-BinaryFile::BinaryFile(const std::string& filename) : filename(filename) {
-    file.open(filename, std::ios::binary | std::ios::in | std::ios::out);
+BinaryFile::BinaryFile(const std::string& filename, FileAccess access) : filename(filename), access(access) {
+    std::ios::openmode mode = std::ios::binary | std::ios::in;
+    if (access == FileAccess::ReadWrite) {
+        mode |= std::ios::out;
+    }
+    file.open(filename, mode);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open file: " + filename);
     }
@@ -30,7 +34,9 @@ size_t BinaryFile::GetPosition() {
 
 void BinaryFile::SetPosition(size_t position) {
     file.seekg(position);
-    file.seekp(position);
+    if (access == FileAccess::ReadWrite) {
+        file.seekp(position);
+    }
 }
 
 size_t BinaryFile::GetLength() {
@@ -41,6 +47,13 @@ size_t BinaryFile::GetLength() {
     return length;
 }
 
+void BinaryFile::Flush() {
+    file.flush();
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + filename);
+    }
+}
+
 uint8_t BinaryFile::ReadByteUnsigned() {
     uint8_t value;
     file.read(reinterpret_cast<char*>(&value), 1);
@@ -62,6 +75,7 @@ int8_t BinaryFile::ReadByteSigned() {
 }
 
 void BinaryFile::WriteByteUnsigned(uint8_t value) {
+    CheckWritable();
     file.write(reinterpret_cast<const char*>(&value), 1);
 }
 
@@ -209,6 +223,7 @@ std::vector<uint8_t> BinaryFile::ReadBytes(size_t count) {
 }
 
 void BinaryFile::WriteBytes(const std::vector<uint8_t>& data) {
+    CheckWritable();
     file.write(reinterpret_cast<const char*>(data.data()), data.size());
 }
 
@@ -253,6 +268,12 @@ int16_t BinaryFile::ReadShort(uint8_t byte1, uint8_t byte2, Endianness endian) {
     return static_cast<int16_t>((hiByte << 8) | loByte);
 }
 
+void BinaryFile::CheckWritable() {
+    if (access != FileAccess::ReadWrite) {
+        throw std::runtime_error("BinaryFile: " + filename + " is open read-only.");
+    }
+}
+
 void BinaryFile::CheckEOF() {
     if (file.eof()) {
         throw std::runtime_error("BinaryFile: Input past end of file.");
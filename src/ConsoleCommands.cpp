@@ -0,0 +1,151 @@
+#include "ConsoleCommands.h"
+#include <cstdio>
+
+ConsoleCommands::ConsoleCommands(Output output)
+    : output(output) {
+    Register("help", "help [command]", "List commands, or describe one", [this](const Arguments& args) {
+        PrintHelp(args);
+    });
+    Register("cancel", "cancel", "Stop the running background command", [this](const Arguments&) {
+        if (busy) {
+            CancelJob();
+        } else {
+            Print("cancel", "Nothing is running");
+        }
+    });
+}
+
+ConsoleCommands::~ConsoleCommands() {
+    Stop();
+}
+
+void ConsoleCommands::Stop() {
+    if (busy) CancelJob();
+    if (worker.joinable()) worker.join();
+}
+
+void ConsoleCommands::Register(const std::string& name, const std::string& usage, const std::string& description, Handler handler) {
+    commands[name] = {usage, description, handler};
+}
+
+void ConsoleCommands::Execute(const std::string& line) {
+    std::vector<std::string> words;
+    std::string error;
+    if (!Tokenize(line, words, error)) {
+        PrintError("", error);
+        return;
+    }
+    if (words.empty()) return;
+
+    auto command = commands.find(words[0]);
+    if (command == commands.end()) {
+        PrintError("", "Unknown command '" + words[0] + "'; type help for a list");
+        return;
+    }
+    command->second.handler(Arguments(words.begin() + 1, words.end()));
+}
+
+bool ConsoleCommands::Tokenize(const std::string& line, std::vector<std::string>& words, std::string& error) {
+    words.clear();
+    std::string word;
+    bool inWord = false;
+    bool quoted = false;
+
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (c == '\\' && i + 1 < line.size() && line[i + 1] == '"') {
+            word += '"';
+            inWord = true;
+            ++i;
+        } else if (c == '"') {
+            // "" is an empty word
+            quoted = !quoted;
+            inWord = true;
+        } else if ((c == ' ' || c == '\t') && !quoted) {
+            if (inWord) words.push_back(word);
+            word.clear();
+            inWord = false;
+        } else {
+            word += c;
+            inWord = true;
+        }
+    }
+    if (quoted) {
+        error = "Unterminated quote";
+        return false;
+    }
+    if (inWord) words.push_back(word);
+    return true;
+}
+
+bool ConsoleCommands::RunAsync(const std::string& name, std::function<void()> work,
+                               std::function<double()> progress, std::function<void()> cancel) {
+    if (busy) {
+        PrintError(name, jobName + " is still running; wait for it or type cancel");
+        return false;
+    }
+    // The previous job has finished but may not have been reaped by Update yet
+    if (worker.joinable()) worker.join();
+
+    jobName = name;
+    jobProgress = progress;
+    jobCancel = cancel;
+    lastReport = std::chrono::steady_clock::now();
+    cancelRequested = false;
+    busy = true;
+
+    worker = std::thread([this, name, work]() {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        char elapsed[32];
+        std::snprintf(elapsed, sizeof(elapsed), "%.2f s", seconds);
+        Print(name, std::string(cancelRequested ? "Cancelled after " : "Finished in ") + elapsed);
+        busy = false;
+    });
+    return true;
+}
+
+void ConsoleCommands::CancelJob() {
+    if (!busy || cancelRequested) return;
+    cancelRequested = true;
+    if (jobCancel) {
+        jobCancel();
+        Print(jobName, "Cancelling...");
+    } else {
+        PrintWarning(jobName, "Cannot be cancelled; it will stop when finished");
+    }
+}
+
+void ConsoleCommands::Update() {
+    if (!busy) {
+        if (worker.joinable()) worker.join();
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (!jobProgress || cancelRequested || now - lastReport < PROGRESS_REPORT_INTERVAL) return;
+    lastReport = now;
+
+    double fraction = jobProgress();
+    if (fraction >= 0.0) {
+        char percent[16];
+        std::snprintf(percent, sizeof(percent), "%.0f%%", fraction * 100.0);
+        Print(jobName, percent);
+    }
+}
+
+void ConsoleCommands::PrintHelp(const Arguments& args) const {
+    if (!args.empty()) {
+        auto command = commands.find(args[0]);
+        if (command == commands.end()) {
+            PrintError("help", "Unknown command '" + args[0] + "'");
+            return;
+        }
+        Print("help", command->second.usage);
+        Print("help", "  " + command->second.description);
+        return;
+    }
+    for (const auto& [name, command] : commands) {
+        Print("help", command.usage + " - " + command.description);
+    }
+}
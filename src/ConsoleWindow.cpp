@@ -1,11 +1,12 @@
 #include "ConsoleWindow.h"
 #include <imgui.h>
-#include <algorithm>
-#include <iostream>
+#include <cstdio>
+#include <ctime>
 
 ConsoleWindow::ConsoleWindow() 
     : scrollToBottom(true) {
     inputBuffer[0] = '\0'; // Initialize empty string
+    mirror.SetStdout(true);
     AddMessage("WIME Editor C++ Console Ready");
 }
 
@@ -19,25 +20,56 @@ void ConsoleWindow::Render() {
     ImGui::End();
 }
 
-void ConsoleWindow::AddMessage(const std::string& message) {
-    messages.push_back(message);
-    if (messages.size() > 1000) { // Limit to 1000 messages
-        messages.pop_front();
+void ConsoleWindow::Update() {
+    drained.clear();
+    queue.Drain(drained);
+    for (const LogRecord& record : drained) {
+        Append(record);
     }
-    scrollToBottom = true;
-    std::cout << "ConsoleWindow::AddMessage: " << message << std::endl;
+    if (size_t dropped = queue.TakeDropped()) {
+        LogRecord record;
+        record.level = LogLevel::Warning;
+        record.message = std::to_string(dropped) + " log messages dropped";
+        record.time = std::chrono::system_clock::now();
+        Append(record);
+    }
+    // One write per frame however many lines arrived
+    mirror.Flush();
+}
+
+void ConsoleWindow::AddMessage(const std::string& message) {
+    queue.Push(LogLevel::Info, std::string(), message);
 }
 
 void ConsoleWindow::AddError(const std::string& error) {
-    AddMessageWithColor("ERROR: " + error, "#FF4444");
+    queue.Push(LogLevel::Error, std::string(), error);
 }
 
 void ConsoleWindow::AddWarning(const std::string& warning) {
-    AddMessageWithColor("WARNING: " + warning, "#FFAA00");
+    queue.Push(LogLevel::Warning, std::string(), warning);
+}
+
+void ConsoleWindow::Post(LogLevel level, const std::string& source, const std::string& message) {
+    queue.Push(level, source, message);
+}
+
+void ConsoleWindow::Append(const LogRecord& record) {
+    // "12:34:56 ERROR [ResourceLoader] message"
+    std::time_t seconds = std::chrono::system_clock::to_time_t(record.time);
+    char prefix[32];
+    std::strftime(prefix, sizeof(prefix), "%H:%M:%S ", std::localtime(&seconds));
+    std::string line = prefix;
+    if (record.level == LogLevel::Error) line += "ERROR ";
+    else if (record.level == LogLevel::Warning) line += "WARNING ";
+    if (!record.source.empty()) line += "[" + record.source + "] ";
+    line += record.message;
+    
+    log.Append(line, record.level);
+    mirror.Write(line);
 }
 
 void ConsoleWindow::Clear() {
-    messages.clear();
+    log.Clear();
     AddMessage("Console cleared");
 }
 
@@ -48,11 +80,28 @@ void ConsoleWindow::SetCommandCallback(std::function<void(const std::string&)> c
 void ConsoleWindow::RenderMessages() {
     ImGui::BeginChild("ScrollingRegion", ImVec2(0, -ImGui::GetFrameHeightWithSpacing()), false, ImGuiWindowFlags_HorizontalScrollbar);
     
-    for (const auto& message : messages) {
-        ImGui::TextWrapped("%s", message.c_str());
+    // Follow new lines only if the view was already at the bottom
+    bool atBottom = ImGui::GetScrollY() >= ImGui::GetScrollMaxY();
+    bool newLines = log.GetTotalAppended() != renderedLines;
+    renderedLines = log.GetTotalAppended();
+    
+    // Lines are never wrapped, so all have the same height and only the visible ones are laid out
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(log.Size()));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            LogBuffer::Line line = log[i];
+            bool coloured = line.level != LogLevel::Info;
+            if (coloured) {
+                ImGui::PushStyleColor(ImGuiCol_Text, line.level == LogLevel::Error ? ERROR_COLOR : WARNING_COLOR);
+            }
+            ImGui::TextUnformatted(line.text.data(), line.text.data() + line.text.size());
+            if (coloured) ImGui::PopStyleColor();
+        }
     }
+    clipper.End();
     
-    if (scrollToBottom) {
+    if (scrollToBottom || (newLines && atBottom)) {
         ImGui::SetScrollHereY(1.0f);
         scrollToBottom = false;
     }
@@ -75,6 +124,7 @@ void ConsoleWindow::RenderInput() {
 
 void ConsoleWindow::ExecuteCommand(const std::string& command) {
     AddMessage("> " + command);
+    scrollToBottom = true;
     
     if (commandCallback) {
         commandCallback(command);
@@ -82,9 +132,3 @@ void ConsoleWindow::ExecuteCommand(const std::string& command) {
         AddMessage("Command callback not set");
     }
 }
-
-void ConsoleWindow::AddMessageWithColor(const std::string& message, const char* color) {
-    // For now, just add the message normally
-    // TODO: Implement colored text when ImGui supports it better
-    AddMessage(message);
-} 
\ No newline at end of file
@@ -4,5 +4,5 @@
 EditorSettings::EditorSettings() 
     : wimeDIRECTORY(""), lastOpenedFile(""), autoSave(true), 
       showDebugInfo(false), windowWidth(1280), windowHeight(720), 
-      windowMaximized(true) {
+      windowMaximized(true), powerSaving(true) {
 } 
\ No newline at end of file
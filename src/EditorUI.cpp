@@ -4,9 +4,24 @@
 #include "PropertiesWindow.h"
 #include "PreviewWindow.h"
 #include "ConsoleWindow.h"
+#include "SearchWindow.h"
+#include "ExportWindow.h"
+#include "ProfilerWindow.h"
+#include "ConsoleCommands.h"
+#include "Profiler.h"
+#include "FrameScheduler.h"
 #include "ResourceLoader.h"
+#include "ResourceViewers.h"
+#include "ResourceDecoders.h"
+#include "ResourceExporter.h"
+#include "MappedFile.h"
 #include <imgui.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
 
 EditorUI::EditorUI() 
     : gameLoaded(false)
@@ -15,7 +30,12 @@ EditorUI::EditorUI()
     , showProperties(true)
     , showPreview(false)
     , showConsole(true)
-    , shouldOpenFile(false) {
+    , showSearch(false)
+    , showExport(false)
+    , showProfiler(false)
+    , shouldOpenFile(false)
+    , shouldExportImages(false)
+    , shouldSaveTrace(false) {
     
     // Initialize file filters
     wimeFilters = {
@@ -35,62 +55,167 @@ void EditorUI::Initialize() {
     propertiesWindow = std::make_unique<PropertiesWindow>();
     previewWindow = std::make_unique<PreviewWindow>();
     consoleWindow = std::make_unique<ConsoleWindow>();
+    searchWindow = std::make_unique<SearchWindow>();
+    exportWindow = std::make_unique<ExportWindow>();
+    profilerWindow = std::make_unique<ProfilerWindow>();
+    searchWindow->SetStringIndex(&stringIndex);
+    previewWindow->SetResourceEdits(&resourceEdits);
     
-    // Set up console command callback
+    // Messages posted from worker threads while the editor is idle
+    consoleWindow->SetOnMessagePosted([]() {
+        FrameScheduler::Wake();
+    });
+    
+    // Commands are dispatched from the UI thread; their background jobs print through the queue
+    consoleCommands = std::make_unique<ConsoleCommands>([this](LogLevel level, const std::string& source, const std::string& message) {
+        consoleWindow->Post(level, source, message);
+    });
+    RegisterConsoleCommands();
     consoleWindow->SetCommandCallback([this](const std::string& command) {
-        // Handle console commands
-        consoleWindow->AddMessage("Command: " + command);
+        consoleCommands->Execute(command);
     });
     
     // Set up resource selection callback
     resourceBrowserWindow->SetOnResourceSelected([this](const std::shared_ptr<ResourceItem>& resource) {
+        SelectResource(resource);
+    });
+    
+    exportWindow->SetOnFinished([this](const ExportResult& result) {
+        for (const auto& error : result.errors) {
+            consoleWindow->AddWarning("Export: " + error);
+        }
+        std::string summary = "Exported " + std::to_string(result.exported) + " images in "
+                            + std::to_string(static_cast<int>(result.seconds * 1000)) + " ms";
+        if (result.cancelled) summary += " (cancelled)";
+        if (result.failed > 0) {
+            consoleWindow->AddError(summary + ", " + std::to_string(result.failed) + " failed");
+        } else {
+            consoleWindow->AddMessage(summary);
+        }
+    });
+    
+    profilerWindow->SetOnSaveTrace([this]() {
+        shouldSaveTrace = true;
+    });
+    
+    // Search hits open the resource and jump to the match
+    searchWindow->SetOnHitSelected([this](const std::shared_ptr<ResourceItem>& resource, size_t offset, size_t length) {
+        selectedResource = resource;
         propertiesWindow->SetSelectedResource(resource);
         previewWindow->SetResource(resource, currentGame ? currentGame->FilePath : "");
-        consoleWindow->AddMessage("Selected resource: " + resource->name);
+        previewWindow->GoToOffset(offset, length);
+        showPreview = true;
     });
     
-    // Set up ResourceLoader debug callback
+    // Keep the string index in step with edits in any string viewer
+    StringResourceViewer::SetEditCallback([this](const std::shared_ptr<ResourceItem>& resource, const std::string& text) {
+        stringIndex.Update(resource, text);
+    });
+    
+    // Debug callbacks may be called from any thread; the console queues them
     ResourceLoader::SetDebugCallback([this](const std::string& message) {
-        consoleWindow->AddMessage("[ResourceLoader] " + message);
+        consoleWindow->Post(LogLevel::Info, "ResourceLoader", message);
     });
     
-    // Set up Game debug callback
     Game::SetDebugCallback([this](const std::string& message) {
-        consoleWindow->AddMessage("[Game] " + message);
+        consoleWindow->Post(LogLevel::Info, "Game", message);
     });
 }
 
 void EditorUI::Render() {
-    RenderMainMenuBar();
-    RenderDockSpace();
+    ScopedTimer timer("EditorUI::Render");
+    if (currentGame) {
+        for (const auto& resFile : currentGame->TakeChangedResourceFiles()) {
+            ReloadChangedResourceFile(resFile);
+        }
+        ReloadDeferredResourceFiles();
+    }
+    {
+        ScopedTimer menuTimer("MainMenuBar + DockSpace");
+        RenderMainMenuBar();
+        RenderDockSpace();
+    }
     
     // Render windows based on visibility
     if (showGameInfo) {
+        ScopedTimer windowTimer("GameInfoWindow");
         gameInfoWindow->Render();
     }
     if (showResourceBrowser) {
+        ScopedTimer windowTimer("ResourceBrowserWindow");
         resourceBrowserWindow->Render();
     }
     if (showProperties) {
+        ScopedTimer windowTimer("PropertiesWindow");
         propertiesWindow->Render();
     }
     if (showPreview) {
+        ScopedTimer windowTimer("PreviewWindow");
         previewWindow->Render();
     }
+    consoleCommands->Update();
+    if (consoleCommands->IsBusy()) {
+        FrameScheduler::RequestRedrawIn(std::chrono::duration<double>(ConsoleCommands::PROGRESS_REPORT_INTERVAL).count());
+    }
+    consoleWindow->Update();
     if (showConsole) {
+        ScopedTimer windowTimer("ConsoleWindow");
         consoleWindow->Render();
     }
+    if (showSearch) {
+        ScopedTimer windowTimer("SearchWindow");
+        searchWindow->Render();
+    }
+    if (showExport) {
+        ScopedTimer windowTimer("ExportWindow");
+        exportWindow->Render(&showExport);
+    }
+    // The search window may be closed, but others show the index once it is built
+    if (stringIndex.IsBuilding()) {
+        FrameScheduler::RequestRedrawIn(FrameScheduler::PROGRESS_INTERVAL);
+    }
+    // Recording stops whenever the overlay is closed
+    if (showProfiler) {
+        ScopedTimer windowTimer("ProfilerWindow");
+        profilerWindow->Render(&showProfiler);
+    } else {
+        Profiler::SetEnabled(false);
+    }
 }
 
 void EditorUI::Shutdown() {
+    // A running command job prints through consoleCommands and the console window,
+    // so it is stopped while both still exist
+    if (consoleCommands) consoleCommands->Stop();
+    consoleCommands.reset();
     gameInfoWindow.reset();
     resourceBrowserWindow.reset();
     propertiesWindow.reset();
     previewWindow.reset();
     consoleWindow.reset();
+    searchWindow.reset();
+    exportWindow.reset();
+    profilerWindow.reset();
+    Profiler::SetEnabled(false);
+    StringResourceViewer::SetEditCallback(nullptr);
+    stringIndex.Clear();
 }
 
 void EditorUI::SetGame(std::unique_ptr<Game> game) {
+    // Cached tilesets and statistics belong to the previous game's files
+    MapResourceViewer::ClearTilesetCache();
+    ResourceAnalysis::ClearCache();
+    resourceEdits.Clear();
+    deferredReloads.clear();
+    // A running job works on the previous game; a find would store its hits after the clear below
+    if (consoleCommands) consoleCommands->Stop();
+    {
+        // Hits from the last find point into the previous game's index
+        std::lock_guard<std::mutex> lock(findMutex);
+        findHits.clear();
+        findPatternLength = 0;
+    }
+    selectedResource.reset();
     currentGame = std::move(game);
     gameLoaded = currentGame != nullptr;
     
@@ -100,8 +225,20 @@ void EditorUI::SetGame(std::unique_ptr<Game> game) {
     if (gameLoaded) {
         gameInfoWindow->SetGame(currentGame.get());
         resourceBrowserWindow->SetGame(currentGame.get());
+        searchWindow->SetGame(currentGame.get());
+        if (currentGame->resource) {
+            stringIndex.BuildAsync(currentGame->resource->items);
+        } else {
+            stringIndex.Clear();
+        }
         propertiesWindow->SetGameFilePath(currentGame->FilePath);
+        propertiesWindow->SetResourceIndex(currentGame->resource.get());
+        previewWindow->SetResourceIndex(currentGame->resource.get());
         previewWindow->SetResource(nullptr, currentGame->FilePath);
+        std::string error;
+        if (!currentGame->WatchResourceFiles([]() { FrameScheduler::Wake(); }, error)) {
+            consoleWindow->AddWarning("Changes to resource files will not be picked up: " + error);
+        }
         consoleWindow->AddMessage("Game loaded: " + currentGame->Name);
         consoleWindow->AddMessage("Game file: " + currentGame->FilePath);
         consoleWindow->AddMessage("Game format: " + std::to_string(static_cast<int>(currentGame->format)));
@@ -114,12 +251,91 @@ void EditorUI::SetGame(std::unique_ptr<Game> game) {
     } else {
         gameInfoWindow->ClearGame();
         resourceBrowserWindow->ClearGame();
+        searchWindow->ClearGame();
+        stringIndex.Clear();
         propertiesWindow->ClearSelection();
+        propertiesWindow->SetResourceIndex(nullptr);
+        previewWindow->SetResourceIndex(nullptr);
         previewWindow->SetResource(nullptr, "");
         consoleWindow->AddMessage("Game unloaded");
     }
 }
 
+void EditorUI::SelectResource(const std::shared_ptr<ResourceItem>& resource) {
+    selectedResource = resource;
+    propertiesWindow->SetSelectedResource(resource);
+    previewWindow->SetResource(resource, currentGame ? currentGame->FilePath : "");
+    consoleWindow->AddMessage("Selected resource: " + resource->name);
+}
+
+void EditorUI::ReloadChangedResourceFile(const std::string& resFile) {
+    std::string name = std::filesystem::path(resFile).filename().string();
+    // Pending edits hold offsets into the old file; saving them over the new one would corrupt it
+    if (resourceEdits.GetEditsByFile().count(resFile)) {
+        // The watcher reports a change once, so remember it for when the edits are gone
+        if (deferredReloads.insert(resFile).second) {
+            consoleWindow->AddWarning(name + " changed on disk but has unsaved edits; it will be reloaded once they are reverted");
+        }
+        return;
+    }
+    deferredReloads.erase(resFile);
+    
+    auto start = std::chrono::steady_clock::now();
+    ResourceFileChanges changes;
+    std::string error;
+    if (!currentGame->ReloadResourceFile(resFile, changes, error)) {
+        consoleWindow->AddError(name + " changed on disk but could not be reloaded: " + error);
+        return;
+    }
+    ApplyResourceFileChanges(resFile, changes);
+    
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    consoleWindow->AddMessage("Reloaded " + name + ": " + std::to_string(changes.replaced.size()) + " replaced, "
+                              + std::to_string(changes.added.size()) + " added, "
+                              + std::to_string(changes.removed.size()) + " removed in " + std::to_string(ms) + " ms");
+}
+
+void EditorUI::ReloadDeferredResourceFiles() {
+    if (deferredReloads.empty()) return;
+    auto editsByFile = resourceEdits.GetEditsByFile();
+    std::vector<std::string> ready;
+    for (const auto& resFile : deferredReloads) {
+        if (!editsByFile.count(resFile)) ready.push_back(resFile);
+    }
+    for (const auto& resFile : ready) {
+        ReloadChangedResourceFile(resFile);
+    }
+}
+
+void EditorUI::ApplyResourceFileChanges(const std::string& resFile, const ResourceFileChanges& changes) {
+    // Only what was decoded from this file is stale
+    MapResourceViewer::ClearTilesetCache(resFile);
+    ResourceAnalysis::ClearCache(resFile);
+    std::vector<std::shared_ptr<ResourceItem>> removed = changes.removed;
+    std::vector<std::shared_ptr<ResourceItem>> added = changes.added;
+    for (const auto& [oldItem, newItem] : changes.replaced) {
+        removed.push_back(oldItem);
+        added.push_back(newItem);
+    }
+    stringIndex.Replace(removed, added);
+    
+    // Keep the selection on the same resource, now read from the new file
+    if (selectedResource && selectedResource->sourceFile == resFile) {
+        auto replacement = std::find_if(changes.replaced.begin(), changes.replaced.end(), [this](const auto& pair) {
+            return pair.first == selectedResource;
+        });
+        if (replacement != changes.replaced.end()) {
+            selectedResource = replacement->second;
+            propertiesWindow->SetSelectedResource(selectedResource);
+            previewWindow->SetResource(selectedResource, currentGame->FilePath);
+        } else {
+            selectedResource.reset();
+            propertiesWindow->ClearSelection();
+            previewWindow->SetResource(nullptr, currentGame->FilePath);
+        }
+    }
+}
+
 void EditorUI::ClearGame() {
     SetGame(nullptr);
 }
@@ -130,6 +346,7 @@ bool EditorUI::HasGame() const {
 
 void EditorUI::SetSettings(const EditorSettings& newSettings) {
     settings = newSettings;
+    FrameScheduler::SetPowerSaving(settings.powerSaving);
 }
 
 EditorSettings& EditorUI::GetSettings() {
@@ -160,11 +377,54 @@ void EditorUI::ShowConsole(bool show) {
     showConsole = show;
 }
 
+void EditorUI::ShowSearch(bool show) {
+    showSearch = show;
+}
+
 void EditorUI::OnFileOpen(const std::string& filePath) {
     settings.lastOpenedFile = filePath;
     consoleWindow->AddMessage("Opening file: " + filePath);
 }
 
+void EditorUI::OnSave() {
+    if (!currentGame || !resourceEdits.HasEdits()) return;
+    
+    std::string error;
+    std::vector<std::pair<std::string, ResourceFileChanges>> reloaded;
+    bool saved = currentGame->SaveEdits(resourceEdits, reloaded, error);
+    
+    // Files saved before a failure were reloaded too
+    for (const auto& [resFile, changes] : reloaded) {
+        ApplyResourceFileChanges(resFile, changes);
+        deferredReloads.erase(resFile);
+    }
+    propertiesWindow->Refresh();
+    previewWindow->Refresh();
+    
+    if (saved) {
+        consoleWindow->AddMessage("Saved all edited resources");
+    } else {
+        consoleWindow->AddError("Save failed: " + error);
+    }
+}
+
+void EditorUI::OnExportImages(const std::string& directory) {
+    if (!currentGame || !currentGame->resource) return;
+    if (exportWindow->Start(*currentGame->resource, directory)) {
+        showExport = true;
+        consoleWindow->AddMessage("Exporting images to " + directory);
+    }
+}
+
+void EditorUI::OnSaveTrace(const std::string& filename) {
+    std::string error;
+    if (Profiler::WriteChromeTrace(filename, error)) {
+        consoleWindow->AddMessage("Saved profiler trace to " + filename);
+    } else {
+        consoleWindow->AddError("Saving profiler trace failed: " + error);
+    }
+}
+
 void EditorUI::OnExit() {
     consoleWindow->AddMessage("Exiting application...");
 }
@@ -179,6 +439,16 @@ void EditorUI::RenderMainMenuBar() {
             if (ImGui::MenuItem("Open Game", "Ctrl+O")) {
                 shouldOpenFile = true;
             }
+            std::string saveLabel = "Save Changes";
+            if (resourceEdits.HasEdits()) {
+                saveLabel += " (" + std::to_string(resourceEdits.Count()) + ")";
+            }
+            if (ImGui::MenuItem(saveLabel.c_str(), nullptr, false, resourceEdits.HasEdits())) {
+                OnSave();
+            }
+            if (ImGui::MenuItem("Export Images...", nullptr, false, gameLoaded && !exportWindow->IsRunning())) {
+                shouldExportImages = true;
+            }
             if (ImGui::MenuItem("Exit", "Alt+F4")) {
                 OnExit();
             }
@@ -190,6 +460,13 @@ void EditorUI::RenderMainMenuBar() {
             ImGui::MenuItem("Properties", nullptr, &showProperties);
             ImGui::MenuItem("Preview", nullptr, &showPreview);
             ImGui::MenuItem("Console", nullptr, &showConsole);
+            ImGui::MenuItem("Search", nullptr, &showSearch);
+            ImGui::MenuItem("Export", nullptr, &showExport);
+            ImGui::MenuItem("Profiler", nullptr, &showProfiler);
+            ImGui::Separator();
+            if (ImGui::MenuItem("Power Saving", nullptr, &settings.powerSaving)) {
+                FrameScheduler::SetPowerSaving(settings.powerSaving);
+            }
             ImGui::EndMenu();
         }
         if (ImGui::BeginMenu("Help")) {
@@ -226,4 +503,388 @@ void EditorUI::SetupDockSpace() {
     
     ImGui::Begin("DockSpace", nullptr, window_flags);
     ImGui::PopStyleVar(2);
-} 
\ No newline at end of file
+} 
+
+namespace {
+
+bool ParseCount(const std::string& text, unsigned long& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    value = std::strtoul(text.c_str(), &end, 10);
+    return *end == '\0' && value > 0;
+}
+
+std::string FormatNumber(const char* format, double value) {
+    char text[64];
+    std::snprintf(text, sizeof(text), format, value);
+    return text;
+}
+
+// Progress shared between a command's job and the UI thread
+struct JobProgress {
+    std::atomic<size_t> done{0};
+    std::atomic<size_t> total{0};
+    std::atomic<bool> cancel{false};
+    
+    double Fraction() const { return total > 0 ? static_cast<double>(done) / total : -1.0; }
+};
+
+} // namespace
+
+void EditorUI::RegisterConsoleCommands() {
+    consoleCommands->Register("find", "find [-i] [-x] <text>",
+        "Search every resource for text, or hex bytes with -x; -i ignores case", [this](const ConsoleCommands::Arguments& args) {
+            RunFindCommand(args);
+        });
+    consoleCommands->Register("select", "select <name> | select #<hit>",
+        "Open a resource by name (e.g. select MMAP 3) or a hit from the last find", [this](const ConsoleCommands::Arguments& args) {
+            RunSelectCommand(args);
+        });
+    consoleCommands->Register("export", "export <directory> [CHAR|IMAG|MMAP ...]",
+        "Export images as PNG files, optionally only the given types", [this](const ConsoleCommands::Arguments& args) {
+            RunExportCommand(args);
+        });
+    consoleCommands->Register("stats", "stats",
+        "Count, size and byte entropy of each resource type", [this](const ConsoleCommands::Arguments& args) {
+            RunStatsCommand(args);
+        });
+    consoleCommands->Register("bench", "bench [read|decode|search|all] [runs]",
+        "Time reading, decoding and searching the loaded game's resources", [this](const ConsoleCommands::Arguments& args) {
+            RunBenchCommand(args);
+        });
+    consoleCommands->Register("reload", "reload [-f]",
+        "Load the current game again from disk; -f discards unsaved edits", [this](const ConsoleCommands::Arguments& args) {
+            RunReloadCommand(args);
+        });
+    consoleCommands->Register("clear", "clear", "Clear the console", [this](const ConsoleCommands::Arguments&) {
+        consoleWindow->Clear();
+    });
+}
+
+void EditorUI::RunFindCommand(const std::vector<std::string>& args) {
+    if (!currentGame || !currentGame->resource) {
+        consoleCommands->PrintError("find", "No game loaded");
+        return;
+    }
+    
+    SearchQuery query;
+    bool hex = false;
+    std::string text;
+    for (const auto& arg : args) {
+        if (arg == "-i") {
+            query.ignoreCase = true;
+        } else if (arg == "-x") {
+            hex = true;
+        } else {
+            if (!text.empty()) text += ' ';
+            text += arg;
+        }
+    }
+    if (text.empty()) {
+        consoleCommands->PrintError("find", "Usage: find [-i] [-x] <text>");
+        return;
+    }
+    if (!hex) {
+        query.pattern.assign(text.begin(), text.end());
+    } else if (!ResourceSearch::ParseHexPattern(text, query.pattern)) {
+        consoleCommands->PrintError("find", "Invalid hex pattern: " + text);
+        return;
+    }
+    
+    auto items = currentGame->resource->items;
+    auto progress = std::make_shared<SearchProgress>();
+    consoleCommands->RunAsync("find", [this, items, query, progress]() {
+        std::vector<SearchHit> hits = ResourceSearch::Search(items, query, progress.get());
+        size_t listed = std::min(hits.size(), MAX_LISTED_HITS);
+        for (size_t i = 0; i < listed; ++i) {
+            char prefix[32];
+            std::snprintf(prefix, sizeof(prefix), "#%zu +0x%06X ", i + 1, hits[i].offset);
+            consoleCommands->Print("find", prefix + hits[i].item->name + " (" + hits[i].item->sourceFile + ")");
+        }
+        std::string summary = std::to_string(hits.size()) + " hits";
+        if (hits.size() >= query.maxHits) summary += " (stopped at the limit)";
+        if (listed < hits.size()) summary += ", first " + std::to_string(listed) + " listed";
+        consoleCommands->Print("find", summary);
+        
+        std::lock_guard<std::mutex> lock(findMutex);
+        findHits = std::move(hits);
+        findPatternLength = query.pattern.size();
+    }, [progress]() {
+        uint64_t total = progress->bytesTotal;
+        return total > 0 ? static_cast<double>(progress->bytesScanned) / total : -1.0;
+    }, [progress]() {
+        progress->cancel = true;
+    });
+}
+
+void EditorUI::RunSelectCommand(const std::vector<std::string>& args) {
+    if (!currentGame || !currentGame->resource) {
+        consoleCommands->PrintError("select", "No game loaded");
+        return;
+    }
+    if (args.empty()) {
+        consoleCommands->PrintError("select", "Usage: select <name> | select #<hit>");
+        return;
+    }
+    
+    // A hit from the last find opens at the match
+    if (args[0][0] == '#') {
+        unsigned long number;
+        if (!ParseCount(args[0].substr(1), number)) {
+            consoleCommands->PrintError("select", "Invalid hit number: " + args[0]);
+            return;
+        }
+        SearchHit hit;
+        size_t length;
+        {
+            std::lock_guard<std::mutex> lock(findMutex);
+            if (number > findHits.size()) {
+                consoleCommands->PrintError("select", "The last find has " + std::to_string(findHits.size()) + " hits");
+                return;
+            }
+            hit = findHits[number - 1];
+            length = findPatternLength;
+        }
+        SelectResource(hit.item);
+        previewWindow->GoToOffset(hit.offset, length);
+        showPreview = true;
+        return;
+    }
+    
+    std::string name;
+    for (const auto& arg : args) {
+        if (!name.empty()) name += ' ';
+        name += arg;
+    }
+    std::shared_ptr<ResourceItem> resource;
+    size_t matches = 0;
+    for (const auto& item : currentGame->resource->items) {
+        if (item->name != name) continue;
+        if (!resource) resource = item;
+        matches++;
+    }
+    if (!resource) {
+        consoleCommands->PrintError("select", "No resource named '" + name + "'");
+        return;
+    }
+    // Names repeat across .res files; the first file wins
+    if (matches > 1) {
+        consoleCommands->PrintWarning("select", std::to_string(matches) + " resources are named '" + name
+                                                + "'; selected the one in " + resource->sourceFile);
+    }
+    SelectResource(resource);
+    showPreview = true;
+}
+
+void EditorUI::RunExportCommand(const std::vector<std::string>& args) {
+    if (!currentGame || !currentGame->resource) {
+        consoleCommands->PrintError("export", "No game loaded");
+        return;
+    }
+    if (args.empty()) {
+        consoleCommands->PrintError("export", "Usage: export <directory> [CHAR|IMAG|MMAP ...]");
+        return;
+    }
+    
+    ExportOptions options;
+    options.outputDirectory = args[0];
+    for (size_t i = 1; i < args.size(); ++i) {
+        ResourceType type;
+        if (!ParseResourceTypeID(args[i], type) || !ResourceExporter::IsImageType(type)) {
+            consoleCommands->PrintError("export", "Not an image type: " + args[i]);
+            return;
+        }
+        options.types.push_back(type);
+    }
+    
+    // Like the export window, work from a copy so the game can be reloaded meanwhile
+    auto index = std::make_shared<ResourceIndex>(*currentGame->resource);
+    auto progress = std::make_shared<ExportProgress>();
+    bool started = consoleCommands->RunAsync("export", [this, index, options, progress]() {
+        ExportResult result = ResourceExporter::ExportImages(*index, options, *progress);
+        for (size_t i = 0; i < result.errors.size() && i < MAX_LISTED_ERRORS; ++i) {
+            consoleCommands->PrintWarning("export", result.errors[i]);
+        }
+        std::string summary = "Exported " + std::to_string(result.exported) + " images ("
+                            + FormatNumber("%.1f MB", result.bytesWritten / (1024.0 * 1024.0)) + ") to " + options.outputDirectory;
+        if (result.skipped > 0) summary += ", " + std::to_string(result.skipped) + " skipped";
+        if (result.failed > 0) {
+            consoleCommands->PrintError("export", summary + ", " + std::to_string(result.failed) + " failed");
+        } else {
+            consoleCommands->Print("export", summary);
+        }
+    }, [progress]() {
+        size_t total = progress->total;
+        return total > 0 ? static_cast<double>(progress->done) / total : -1.0;
+    }, [progress]() {
+        progress->cancel = true;
+    });
+    if (started) consoleCommands->Print("export", "Exporting images to " + options.outputDirectory);
+}
+
+void EditorUI::RunStatsCommand(const std::vector<std::string>&) {
+    if (!currentGame || !currentGame->resource) {
+        consoleCommands->PrintError("stats", "No game loaded");
+        return;
+    }
+    
+    auto items = currentGame->resource->items;
+    auto progress = std::make_shared<AnalysisProgress>();
+    consoleCommands->RunAsync("stats", [this, items, progress]() {
+        std::map<std::string, TypeStatistics> byType;
+        std::vector<std::string> errors;
+        auto files = ResourceAnalysis::MapSourceFiles(items, errors);
+        for (const auto& error : errors) {
+            consoleCommands->PrintWarning("stats", error);
+        }
+        if (!ResourceAnalysis::ComputeTypeStatistics(items, files, byType, progress.get())) return;
+        
+        char line[128];
+        std::snprintf(line, sizeof(line), "%-6s %8s %12s %10s %10s %8s %8s", "Type", "Count", "Bytes", "Min", "Max", "Unique", "Entropy");
+        consoleCommands->Print("stats", line);
+        size_t totalCount = 0;
+        uint64_t totalBytes = 0;
+        for (const auto& [type, stats] : byType) {
+            std::snprintf(line, sizeof(line), "%-6s %8zu %12llu %10u %10u %8zu %8.3f", type.c_str(), stats.count,
+                          static_cast<unsigned long long>(stats.bytes), stats.smallest, stats.largest,
+                          stats.content.uniqueValues, stats.content.entropy);
+            consoleCommands->Print("stats", line);
+            totalCount += stats.count;
+            totalBytes += stats.bytes;
+        }
+        std::snprintf(line, sizeof(line), "%-6s %8zu %12llu", "Total", totalCount, static_cast<unsigned long long>(totalBytes));
+        consoleCommands->Print("stats", line);
+        consoleCommands->Print("stats", "Files: " + std::to_string(files.size()));
+    }, [progress, total = items.size()]() {
+        return total > 0 ? static_cast<double>(progress->itemsDone) / total : -1.0;
+    }, [progress]() {
+        progress->cancel = true;
+    });
+}
+
+void EditorUI::RunBenchCommand(const std::vector<std::string>& args) {
+    if (!currentGame || !currentGame->resource) {
+        consoleCommands->PrintError("bench", "No game loaded");
+        return;
+    }
+    
+    bool read = true, decode = true, search = true;
+    unsigned long runs = 3;
+    for (const auto& arg : args) {
+        if (arg == "read" || arg == "decode" || arg == "search") {
+            read = arg == "read";
+            decode = arg == "decode";
+            search = arg == "search";
+        } else if (arg != "all" && !ParseCount(arg, runs)) {
+            consoleCommands->PrintError("bench", "Usage: bench [read|decode|search|all] [runs]");
+            return;
+        }
+    }
+    
+    struct BenchState {
+        JobProgress progress;
+        SearchProgress search;   // Its cancel flag is set along with progress.cancel
+    };
+    auto items = currentGame->resource->items;
+    auto state = std::make_shared<BenchState>();
+    state->progress.total = runs * (read + decode + search);
+    
+    consoleCommands->RunAsync("bench", [this, items, state, runs, read, decode, search]() {
+        // Times runs of pass and prints best and median; amount is the work done per run
+        auto measure = [&](const char* name, const char* unit, double amount, auto pass) {
+            std::vector<double> seconds;
+            for (unsigned long run = 0; run < runs && !state->progress.cancel; ++run) {
+                auto start = std::chrono::steady_clock::now();
+                pass();
+                seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+                state->progress.done++;
+            }
+            if (state->progress.cancel || seconds.empty()) return;
+            std::sort(seconds.begin(), seconds.end());
+            double best = seconds.front();
+            double median = seconds[seconds.size() / 2];
+            consoleCommands->Print("bench", std::string(name) + ": best " + FormatNumber("%.2f", best * 1000.0)
+                                          + " ms, median " + FormatNumber("%.2f", median * 1000.0) + " ms, "
+                                          + FormatNumber("%.1f", best > 0.0 ? amount / best : 0.0) + " " + unit);
+        };
+        
+        uint64_t totalBytes = 0;
+        for (const auto& item : items) totalBytes += item->size;
+        const double megabytes = totalBytes / (1024.0 * 1024.0);
+        
+        // Map every file and histogram every chunk, as stats does
+        if (read) {
+            measure("read", "MB/s", megabytes, [&]() {
+                std::vector<std::string> errors;
+                auto files = ResourceAnalysis::MapSourceFiles(items, errors);
+                std::vector<uint64_t> histogram(256);
+                for (const auto& item : items) {
+                    auto file = files.find(item->sourceFile);
+                    const uint8_t* data;
+                    size_t size;
+                    if (file != files.end() && ResourceAnalysis::ChunkBytes(*file->second, *item, data, size)) {
+                        ResourceAnalysis::ComputeHistogram(data, size, histogram.data());
+                    }
+                }
+            });
+        }
+        
+        // Decode every tileset, map and image the way the viewers do
+        if (decode) {
+            size_t decodable = 0;
+            for (const auto& item : items) {
+                decodable += ResourceExporter::IsImageType(item->type);
+            }
+            measure("decode", "resources/s", static_cast<double>(decodable), [&]() {
+                for (const auto& item : items) {
+                    if (state->progress.cancel) return;
+                    if (item->type == ResourceType::CHAR) {
+                        ResourceDecoders::BuildTileAtlas(ResourceDecoders::ReadTileData(item->sourceFile, item->offset));
+                    } else if (item->type == ResourceType::MMAP) {
+                        MapCells map;
+                        ResourceDecoders::ReadMap(*item, map);
+                    } else if (item->type == ResourceType::IMAG) {
+                        IndexedImage image;
+                        ResourceDecoders::ReadImage(*item, 4, image);
+                    }
+                }
+            });
+        }
+        
+        // A pattern that rarely occurs, so the scan rather than hit collection is timed
+        if (search) {
+            SearchQuery query;
+            query.pattern = {0xDE, 0xAD, 0xBE, 0xEF};
+            measure("search", "MB/s", megabytes, [&]() {
+                ResourceSearch::Search(items, query, &state->search);
+            });
+        }
+    }, [state]() {
+        return state->progress.Fraction();
+    }, [state]() {
+        state->progress.cancel = true;
+        state->search.cancel = true;
+    });
+}
+
+void EditorUI::RunReloadCommand(const std::vector<std::string>& args) {
+    if (!currentGame) {
+        consoleCommands->PrintError("reload", "No game loaded");
+        return;
+    }
+    bool force = !args.empty() && args[0] == "-f";
+    if (resourceEdits.HasEdits() && !force) {
+        consoleCommands->PrintError("reload", std::to_string(resourceEdits.Count())
+                                              + " unsaved edits; save them first or use reload -f to discard them");
+        return;
+    }
+    
+    std::string filePath = currentGame->FilePath;
+    auto game = std::make_unique<Game>();
+    if (game->LoadGame(filePath)) {
+        SetGame(std::move(game));
+        consoleCommands->Print("reload", "Reloaded " + filePath);
+    } else {
+        consoleCommands->PrintError("reload", "Failed to load " + filePath);
+    }
+}
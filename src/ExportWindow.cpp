@@ -0,0 +1,80 @@
+#include "ExportWindow.h"
+#include "FrameScheduler.h"
+#include <imgui.h>
+#include <cstdio>
+
+ExportWindow::~ExportWindow() {
+    Cancel();
+}
+
+void ExportWindow::Cancel() {
+    if (progress) progress->cancel = true;
+    if (worker.joinable()) worker.join();
+    running = false;
+}
+
+bool ExportWindow::Start(const ResourceIndex& index, const std::string& directory) {
+    if (running) return false;
+    if (worker.joinable()) worker.join();
+
+    progress = std::make_unique<ExportProgress>();
+    outputDirectory = directory;
+    startTime = std::chrono::steady_clock::now();
+    summary.clear();
+    resultReady = false;
+    running = true;
+
+    ExportOptions options;
+    options.outputDirectory = directory;
+    ExportProgress* exportProgress = progress.get();
+    worker = std::thread([this, index, options, exportProgress]() {
+        ExportResult result = ResourceExporter::ExportImages(index, options, *exportProgress);
+        std::lock_guard<std::mutex> lock(resultMutex);
+        pendingResult = std::move(result);
+        resultReady = true;
+        running = false;
+        FrameScheduler::Wake();
+    });
+    return true;
+}
+
+void ExportWindow::Render(bool* open) {
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        if (resultReady) {
+            resultReady = false;
+            char text[160];
+            std::snprintf(text, sizeof(text), "%s%zu images, %.1f MB in %.2f s (%zu skipped, %zu failed)",
+                          pendingResult.cancelled ? "Cancelled after " : "Exported ", pendingResult.exported,
+                          pendingResult.bytesWritten / 1048576.0, pendingResult.seconds, pendingResult.skipped,
+                          pendingResult.failed);
+            summary = text;
+            if (onFinished) onFinished(pendingResult);
+        }
+    }
+
+    if (!ImGui::Begin("Export", open)) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::TextWrapped("Output: %s", outputDirectory.empty() ? "(none)" : outputDirectory.c_str());
+    if (running && progress) {
+        FrameScheduler::RequestRedrawIn(FrameScheduler::PROGRESS_INTERVAL);
+        size_t total = progress->total;
+        size_t done = progress->done;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        float fraction = total ? static_cast<float>(done) / total : 0.0f;
+        char overlay[32];
+        std::snprintf(overlay, sizeof(overlay), "%zu / %zu", done, total);
+        ImGui::ProgressBar(fraction, ImVec2(-80.0f, 0.0f), overlay);
+        ImGui::SameLine();
+        if (ImGui::Button("Cancel")) progress->cancel = true;
+        if (seconds > 0.0) {
+            ImGui::Text("%.1f images/s, %.1f MB/s", done / seconds, progress->bytesWritten / 1048576.0 / seconds);
+        }
+    } else if (!summary.empty()) {
+        ImGui::TextUnformatted(summary.c_str());
+    }
+    ImGui::End();
+}
@@ -41,6 +41,17 @@ std::string FileDialog::SaveFile(GLFWwindow* window, const std::string& title,
     return "";
 }
 
+std::string FileDialog::SelectFolder(GLFWwindow* window, const std::string& title) {
+    try {
+        auto result = pfd::select_folder(title, "");
+        return result.result();
+    } catch (const std::exception& e) {
+        std::cerr << "Folder dialog error: " << e.what() << std::endl;
+    }
+    
+    return "";
+}
+
 std::string FileDialog::GetFilterString(const std::vector<FileFilter>& filters) {
     std::string result;
     for (const auto& filter : filters) {
@@ -0,0 +1,118 @@
+#include "FormatDetector.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+
+namespace {
+
+uint32_t Get32(const uint8_t* p, Endianness endian) {
+    return endian == Endianness::Big
+        ? (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3]
+        : (uint32_t(p[3]) << 24) | (uint32_t(p[2]) << 16) | (uint32_t(p[1]) << 8) | p[0];
+}
+
+uint16_t Get16(const uint8_t* p, Endianness endian) {
+    return endian == Endianness::Big ? uint16_t((p[0] << 8) | p[1]) : uint16_t((p[1] << 8) | p[0]);
+}
+
+std::string ToLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+const char* FormatName(GameFormat format) {
+    switch (format) {
+        case GameFormat::PC: return "PC";
+        case GameFormat::Amiga: return "Amiga";
+        case GameFormat::AppleIIGS: return "Apple IIGS";
+        case GameFormat::AtariST: return "Atari ST";
+        default: return "Unknown";
+    }
+}
+
+} // namespace
+
+GameFormat FormatDetector::FormatFromExecutable(const uint8_t* data, size_t size) {
+    if (size >= 2 && data[0] == 'M' && data[1] == 'Z') return GameFormat::PC;
+    // HUNK_HEADER
+    if (size >= 4 && Get32(data, Endianness::Big) == 0x000003F3) return GameFormat::Amiga;
+    // GEMDOS program header: BRA.S over the 28-byte header
+    if (size >= 28 && Get16(data, Endianness::Big) == 0x601A) return GameFormat::AtariST;
+    // OMF segment header: NUMLEN 4, VERSION 1 or 2, BANKSIZE 0 or 64K
+    if (size >= 20 && data[0x0E] == 4 && (data[0x0F] == 1 || data[0x0F] == 2)) {
+        uint32_t bankSize = Get32(data + 0x10, Endianness::Little);
+        if (bankSize == 0 || bankSize == 0x10000) return GameFormat::AppleIIGS;
+    }
+    return GameFormat::Unknown;
+}
+
+GameFormat FormatDetector::FormatFromName(const std::string& gamePath) {
+    std::string name = ToLower(std::filesystem::path(gamePath).filename().string());
+    if (name == "start.exe" || name == "lord.exe") return GameFormat::PC;
+    if (name.find("earth.sys16") != std::string::npos) return GameFormat::AppleIIGS;
+    if (name.find("warinmiddleearth") != std::string::npos) return GameFormat::Amiga;
+    if (name == "command.prg") return GameFormat::AtariST;
+    return GameFormat::Unknown;
+}
+
+Endianness FormatDetector::PlatformEndianness(GameFormat format) {
+    return (format == GameFormat::PC || format == GameFormat::AppleIIGS) ? Endianness::Little : Endianness::Big;
+}
+
+DetectedFormat FormatDetector::Detect(const std::string& gamePath, const std::vector<std::string>& resFiles) {
+    DetectedFormat result;
+
+    GameFormat fromExecutable = GameFormat::Unknown;
+    try {
+        BinaryFile executable(gamePath);
+        if (executable.IsOpen()) {
+            size_t sample = std::min<size_t>(EXECUTABLE_SAMPLE, executable.GetLength());
+            std::vector<uint8_t> bytes = executable.ReadBytes(sample);
+            fromExecutable = FormatFromExecutable(bytes.data(), bytes.size());
+        }
+    } catch (const std::exception&) {
+        // Unreadable executables fall back to the name
+    }
+    GameFormat fromName = FormatFromName(gamePath);
+    result.format = fromExecutable != GameFormat::Unknown ? fromExecutable : fromName;
+    result.reason = std::string("platform ") + FormatName(result.format)
+                  + (fromExecutable != GameFormat::Unknown ? " from executable header" :
+                     fromName != GameFormat::Unknown ? " from file name" : "");
+
+    // Each header is read once here, with the loader's rule; the probes are kept so
+    // loading does not read them again. The platform's order breaks per-file ties.
+    const Endianness platformEndian = PlatformEndianness(result.format);
+    int little = 0;
+    int big = 0;
+    for (const auto& resFile : resFiles) {
+        ProbedResourceFile probed;
+        probed.path = resFile;
+        try {
+            BinaryFile file(resFile);
+            probed.error = ResourceLoader::ProbeResourceHeader(file, platformEndian, probed.probe);
+        } catch (const std::exception&) {
+            probed.error = ResourceHeaderError::CannotOpen;
+        }
+        if (probed.error == ResourceHeaderError::None) {
+            (probed.probe.endian == Endianness::Little ? little : big)++;
+        }
+        result.resourceFiles.push_back(probed);
+    }
+
+    // The game's order is the one most of its files use; single files can still differ
+    if (little != big) {
+        result.endian = little > big ? Endianness::Little : Endianness::Big;
+        result.endianFromResources = true;
+        result.reason += std::string(", ") + (little > big ? "little" : "big") + "-endian resources ("
+                       + std::to_string(little) + " LE / " + std::to_string(big) + " BE files)";
+        // The resources win: they are what gets parsed
+        if (result.format != GameFormat::Unknown && platformEndian != result.endian) {
+            result.reason += ", which " + std::string(FormatName(result.format)) + " data does not use";
+        }
+    } else {
+        result.endian = platformEndian;
+        result.reason += std::string(", ") + (result.endian == Endianness::Little ? "little" : "big")
+                       + "-endian by platform";
+    }
+    return result;
+}
@@ -0,0 +1,57 @@
+#include "FrameScheduler.h"
+#include <imgui.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+
+bool FrameScheduler::powerSaving = true;
+bool FrameScheduler::continuous = false;
+double FrameScheduler::redrawAt = -1.0;
+int FrameScheduler::framesPending = FRAMES_AFTER_EVENT;
+
+void FrameScheduler::RequestContinuous() {
+    continuous = true;
+}
+
+void FrameScheduler::RequestRedrawIn(double seconds) {
+    double at = glfwGetTime() + seconds;
+    redrawAt = redrawAt < 0.0 ? at : std::min(redrawAt, at);
+}
+
+void FrameScheduler::Wake() {
+    glfwPostEmptyEvent();
+}
+
+void FrameScheduler::WaitForNextFrame() {
+    double now = glfwGetTime();
+    bool due = redrawAt >= 0.0 && now >= redrawAt;
+    if (due) redrawAt = -1.0;
+    bool drawNow = continuous || due || framesPending > 0 || !powerSaving;
+    continuous = false;
+
+    if (drawNow) {
+        if (framesPending > 0) framesPending--;
+        glfwPollEvents();
+        return;
+    }
+
+    double timeout = redrawAt < 0.0 ? -1.0 : redrawAt - now;
+    if (ImGui::GetCurrentContext() && ImGui::GetIO().WantTextInput) {
+        timeout = timeout < 0.0 ? TEXT_CURSOR_BLINK : std::min(timeout, TEXT_CURSOR_BLINK);
+    }
+
+    if (timeout < 0.0) {
+        glfwWaitEvents();
+    } else {
+        glfwWaitEventsTimeout(timeout);
+    }
+
+    // Woken early by input or Wake(): let ImGui react over a few frames and look again
+    // once hover delays have passed. A timed wake-up needs just this frame.
+    double elapsed = glfwGetTime() - now;
+    if (timeout < 0.0 || elapsed < timeout - 0.001) {
+        framesPending = FRAMES_AFTER_EVENT - 1;
+        RequestRedrawIn(HOVER_FOLLOW_UP);
+    } else if (redrawAt >= 0.0 && glfwGetTime() >= redrawAt) {
+        redrawAt = -1.0;
+    }
+}
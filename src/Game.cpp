@@ -2,9 +2,13 @@
 #include "FileFormat.h"
 #include "BinaryFile.h"
 #include "ResourceLoader.h"
+#include "ResourceWriter.h"
+#include "ResourceIndexCache.h"
+#include "FormatDetector.h"
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
+#include <map>
 
 std::function<void(const std::string&)> Game::debugCallback = nullptr;
 
@@ -38,65 +42,202 @@ void Game::UnloadGame() {
     IsLoaded = false;
     Name.clear();
     FilePath.clear();
+    watcher.Stop();
+    resourceFiles.clear();
+    fileEndianness.clear();
     resource.reset();
     fileFormat.reset();
     format = GameFormat::Unknown;
+    endianness = Endianness::Big;
 }
 
-GameFormat Game::DetectFormat(const std::string& filePath, BinaryFile& file) {
-    std::string fname = ToLower(std::filesystem::path(filePath).filename().string());
-    if (fname == "start.exe" || fname == "lord.exe") return GameFormat::PC;
-    if (fname.find("earth.sys16") != std::string::npos) return GameFormat::AppleIIGS;
-    if (fname.find("warinmiddleearth") != std::string::npos) return GameFormat::Amiga;
-    if (fname == "command.prg") return GameFormat::AtariST;
-    // Optionally, check file header bytes for more robust detection
-    // ...
-    return GameFormat::Unknown;
+GameFormat Game::DetectFormat(const std::string& filePath, const std::vector<std::string>& resFiles,
+                              std::vector<ProbedResourceFile>& probed) {
+    // Samples the executable and every .res header once; nothing is parsed yet
+    DetectedFormat detected = FormatDetector::Detect(filePath, resFiles);
+    endianness = detected.endian;
+    probed = std::move(detected.resourceFiles);
+    if (debugCallback) debugCallback("Format detection: " + detected.reason);
+    return detected.format;
 }
 
-void Game::LoadRealResources(const std::string& gamePath) {
+Endianness Game::GetEndianness() const {
+    // Decided by DetectFormat, from the .res headers where they are conclusive
+    return endianness;
+}
+
+Endianness Game::GetResourceFileEndianness(const std::string& resFile) const {
+    auto found = fileEndianness.find(resFile);
+    return found != fileEndianness.end() ? found->second : endianness;
+}
+
+bool Game::SaveEdits(ResourceEdits& edits, std::vector<std::pair<std::string, ResourceFileChanges>>& reloaded,
+                     std::string& error) {
+    if (!resource) return false;
+    
+    for (const auto& [filename, fileEdits] : edits.GetEditsByFile()) {
+        if (debugCallback) debugCallback("Saving " + std::to_string(fileEdits.size()) + " edited resources to " + filename);
+        if (!ResourceWriter::SaveResourceFile(filename, GetResourceFileEndianness(filename), fileEdits, error)) {
+            if (debugCallback) debugCallback("Save failed: " + error);
+            return false;
+        }
+        for (const auto& edit : fileEdits) {
+            edits.Discard(*edit.item);
+        }
+        // Chunks may have moved; fresh entries replace the old ones rather than editing
+        // items that search, export and console jobs may be reading
+        ResourceFileChanges changes;
+        if (!ReloadResourceFile(filename, changes, error)) {
+            error = "Saved " + filename + " but could not reload it: " + error;
+            return false;
+        }
+        reloaded.emplace_back(filename, std::move(changes));
+    }
+    return true;
+}
+
+std::unique_ptr<ResourceIndex> Game::LoadResourceFile(const std::string& resFile, Endianness endian) {
+    ResourceHeaderProbe probe;
     try {
-        // Determine endianness based on format
-        Endianness endian = (format == GameFormat::PC || format == GameFormat::AppleIIGS) ? 
-                           Endianness::Little : Endianness::Big;
-        
-        // Get the directory containing the game file
-        std::filesystem::path gameFilePath(gamePath);
-        std::string gameDir = gameFilePath.parent_path().string();
-        
-        if (debugCallback) debugCallback("Looking for .res files in: " + gameDir);
-        
-        // Look for .res files in the same directory (case insensitive)
-        std::vector<std::string> resourceFiles;
-        if (debugCallback) debugCallback("Scanning directory for resource files...");
-        for (const auto& entry : std::filesystem::directory_iterator(gameDir)) {
-            if (entry.is_regular_file()) {
-                std::string filename = entry.path().filename().string();
-                std::string extension = ToLower(entry.path().extension().string());
-                if (debugCallback) debugCallback("Found file: " + filename + " (ext: " + extension + ")");
-                
-                if (extension == ".res" ) 
-                {
-                std::string resFile = entry.path().string();
-                if (debugCallback) debugCallback("Found resource file: " + resFile);
-                
-                // Try to load the resource file
-                auto loadedResource = ResourceLoader::LoadResourceFile(resFile, endian);
-                if (loadedResource) {
-                    // Merge with existing resources or replace
-                    if (!resource) {
-                        resource = std::move(loadedResource);
-                    } else {
-                        // Merge resources
-                        for (const auto& item : loadedResource->items) {
-                            resource->AddItem(item->name, item->offset, item->size, item->type, item->sourceFile);
-                        }
-                    }
-                    if (debugCallback) debugCallback("Successfully loaded resources from: " + resFile);
+        BinaryFile file(resFile);
+        ResourceHeaderError headerError = ResourceLoader::ProbeResourceHeader(file, endian, probe);
+        if (headerError != ResourceHeaderError::None) {
+            if (debugCallback) debugCallback("Rejected " + resFile + ": " + ResourceLoader::DescribeHeaderError(headerError));
+            return nullptr;
+        }
+    } catch (const std::exception& e) {
+        if (debugCallback) debugCallback(e.what());
+        return nullptr;
+    }
+    return LoadProbedResourceFile(resFile, probe);
+}
+
+std::unique_ptr<ResourceIndex> Game::LoadProbedResourceFile(const std::string& resFile, const ResourceHeaderProbe& probe) {
+    // The probe settles the byte order before the cache is consulted, since cache
+    // entries are per byte order, and it is remembered for saving and reloading
+    const Endianness endian = probe.endian;
+    if (endian != endianness && debugCallback) {
+        debugCallback(resFile + " is " + (endian == Endianness::Little ? "little" : "big") + "-endian, unlike the rest of the game");
+    }
+    
+    // Without a key the file cannot be matched to a cache entry, but may still parse
+    ResourceFileKey key;
+    std::string error;
+    bool haveKey = ResourceIndexCache::IsEnabled() && ResourceIndexCache::ComputeKey(resFile, key, error);
+    if (haveKey) {
+        if (auto cached = ResourceIndexCache::Load(resFile, endian, key, error)) {
+            if (debugCallback) debugCallback("Loaded " + std::to_string(cached->items.size()) + " resources from the index cache for " + resFile);
+            fileEndianness[resFile] = endian;
+            return cached;
+        }
+    }
+    if (debugCallback && !error.empty()) debugCallback("Index cache: " + error);
+    
+    auto loaded = ResourceLoader::LoadResourceFile(resFile, probe);
+    if (loaded) fileEndianness[resFile] = endian;
+    if (loaded && haveKey && !ResourceIndexCache::Store(resFile, endian, key, *loaded, error)) {
+        if (debugCallback) debugCallback("Index cache: " + error);
+    }
+    return loaded;
+}
+
+bool Game::WatchResourceFiles(std::function<void()> onChange, std::string& error) {
+    return watcher.Start(resourceFiles, onChange, error);
+}
+
+bool Game::ReloadResourceFile(const std::string& resFile, ResourceFileChanges& changes, std::string& error) {
+    if (!resource) {
+        error = "No resources loaded";
+        return false;
+    }
+    auto loaded = LoadResourceFile(resFile, GetResourceFileEndianness(resFile));
+    if (!loaded) {
+        error = "Failed to load resources from " + resFile;
+        return false;
+    }
+    
+    // Resource numbers are unique per type within one file
+    std::map<std::pair<ResourceType, uint16_t>, std::shared_ptr<ResourceItem>> fresh;
+    for (const auto& item : loaded->items) {
+        fresh.emplace(std::make_pair(item->type, item->number), item);
+    }
+    
+    // The file's entries are contiguous; the new ones go where the old ones started
+    std::vector<std::shared_ptr<ResourceItem>> items;
+    items.reserve(resource->items.size() + loaded->items.size());
+    bool inserted = false;
+    for (const auto& item : resource->items) {
+        if (item->sourceFile != resFile) {
+            items.push_back(item);
+            continue;
+        }
+        if (!inserted) {
+            items.insert(items.end(), loaded->items.begin(), loaded->items.end());
+            inserted = true;
+        }
+        auto match = fresh.find(std::make_pair(item->type, item->number));
+        if (match != fresh.end()) {
+            changes.replaced.emplace_back(item, match->second);
+            fresh.erase(match);
+        } else {
+            changes.removed.push_back(item);
+        }
+    }
+    if (!inserted) {
+        items.insert(items.end(), loaded->items.begin(), loaded->items.end());
+        resourceFiles.push_back(resFile);
+    }
+    for (const auto& item : loaded->items) {
+        if (fresh.count(std::make_pair(item->type, item->number))) changes.added.push_back(item);
+    }
+    
+    resource->items = std::move(items);
+    if (debugCallback) debugCallback("Reloaded " + resFile + ": " + std::to_string(changes.replaced.size()) + " replaced, "
+                                     + std::to_string(changes.added.size()) + " added, "
+                                     + std::to_string(changes.removed.size()) + " removed");
+    return true;
+}
+
+std::vector<std::string> Game::FindResourceFiles(const std::string& gamePath) {
+    std::vector<std::string> resFiles;
+    std::string gameDir = std::filesystem::path(gamePath).parent_path().string();
+    if (gameDir.empty()) gameDir = ".";
+    if (debugCallback) debugCallback("Looking for .res files in: " + gameDir);
+    
+    // Look for .res files in the same directory (case insensitive)
+    for (const auto& entry : std::filesystem::directory_iterator(gameDir)) {
+        if (entry.is_regular_file() && ToLower(entry.path().extension().string()) == ".res") {
+            resFiles.push_back(entry.path().string());
+            if (debugCallback) debugCallback("Found resource file: " + resFiles.back());
+        }
+    }
+    return resFiles;
+}
+
+void Game::LoadRealResources(const std::vector<ProbedResourceFile>& resFiles) {
+    try {
+        for (const auto& probed : resFiles) {
+            const std::string& resFile = probed.path;
+            if (probed.error != ResourceHeaderError::None) {
+                if (debugCallback) debugCallback("Rejected " + resFile + ": " + ResourceLoader::DescribeHeaderError(probed.error));
+                continue;
+            }
+            // Try to load the resource file
+            auto loadedResource = LoadProbedResourceFile(resFile, probed.probe);
+            if (loadedResource) {
+                resourceFiles.push_back(resFile);
+                // Merge with existing resources or replace
+                if (!resource) {
+                    resource = std::move(loadedResource);
                 } else {
-                    if (debugCallback) debugCallback("Failed to load resources from: " + resFile);
-                }
+                    // Merge resources
+                    for (const auto& item : loadedResource->items) {
+                        resource->AddItem(item->name, item->offset, item->size, item->type, item->sourceFile, item->number);
+                    }
                 }
+                if (debugCallback) debugCallback("Successfully loaded resources from: " + resFile);
+            } else {
+                if (debugCallback) debugCallback("Failed to load resources from: " + resFile);
             }
         }
         
@@ -121,7 +262,9 @@ bool Game::InitializeGameData(const std::string& filePath) {
             std::cerr << "Failed to open game file: " << filePath << std::endl;
             return false;
         }
-        format = DetectFormat(filePath, file);
+        std::vector<std::string> resFiles = FindResourceFiles(filePath);
+        std::vector<ProbedResourceFile> probedFiles;
+        format = DetectFormat(filePath, resFiles, probedFiles);
         std::string formatStr;
         switch (format) {
             case GameFormat::PC: formatStr = "PC"; break;
@@ -133,7 +276,7 @@ bool Game::InitializeGameData(const std::string& filePath) {
         if (debugCallback) debugCallback("Detected game format: " + formatStr);
         
         // Load real resources from .res files
-        LoadRealResources(filePath);
+        LoadRealResources(probedFiles);
         
         return true;
     } catch (const std::exception& e) {
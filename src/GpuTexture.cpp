@@ -0,0 +1,66 @@
+#include "GpuTexture.h"
+#include <GLFW/glfw3.h>
+#include <utility>
+
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+GpuTexture::~GpuTexture() {
+    Release();
+}
+
+GpuTexture::GpuTexture(GpuTexture&& other) noexcept
+    : textureID(std::exchange(other.textureID, 0))
+    , width(std::exchange(other.width, 0))
+    , height(std::exchange(other.height, 0)) {
+}
+
+GpuTexture& GpuTexture::operator=(GpuTexture&& other) noexcept {
+    if (this != &other) {
+        Release();
+        textureID = std::exchange(other.textureID, 0);
+        width = std::exchange(other.width, 0);
+        height = std::exchange(other.height, 0);
+    }
+    return *this;
+}
+
+void GpuTexture::Upload(const uint32_t* pixels, int newWidth, int newHeight) {
+    if (!pixels || newWidth <= 0 || newHeight <= 0) return;
+
+    GLint previousTexture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+
+    if (textureID == 0) {
+        glGenTextures(1, &textureID);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        // Pixel art: never filter between palette entries
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, textureID);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (newWidth == width && newHeight == height) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, newWidth, newHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        width = newWidth;
+        height = newHeight;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previousTexture));
+}
+
+void GpuTexture::Release() {
+    if (textureID != 0) {
+        glDeleteTextures(1, &textureID);
+        textureID = 0;
+    }
+    width = 0;
+    height = 0;
+}
@@ -0,0 +1,239 @@
+#include "HexView.h"
+#include "ResourceSearch.h"
+#include <imgui.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+    const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+    // Column layout of a formatted line: "OOOOOOOO: XX XX ... XX  |ascii...........|"
+    constexpr size_t ADDRESS_CHARS = 10;
+    constexpr size_t HEX_COLUMN = ADDRESS_CHARS;
+    constexpr size_t ASCII_COLUMN = HEX_COLUMN + HexView::BYTES_PER_LINE * 3 + 2;
+}
+
+HexView::HexView() : lineCache(LINE_CACHE_SIZE) {
+}
+
+void HexView::SetData(const std::vector<uint8_t>* newData) {
+    if (newData == data) return;
+    data = newData;
+    for (CachedLine& cached : lineCache) {
+        cached.line = SIZE_MAX;
+    }
+    selectionStart = selectionLength = 0;
+    searchStatus.clear();
+}
+
+void HexView::FormatLine(size_t line, std::string& out) const {
+    const size_t start = line * BYTES_PER_LINE;
+    const size_t count = std::min(BYTES_PER_LINE, data->size() - start);
+    const uint8_t* bytes = data->data() + start;
+
+    out.assign(ASCII_COLUMN + BYTES_PER_LINE + 2, ' ');
+    for (int i = 7; i >= 0; --i) {
+        out[7 - i] = HEX_DIGITS[(start >> (i * 4)) & 0xF];
+    }
+    out[8] = ':';
+    for (size_t i = 0; i < count; ++i) {
+        out[HEX_COLUMN + i * 3] = HEX_DIGITS[bytes[i] >> 4];
+        out[HEX_COLUMN + i * 3 + 1] = HEX_DIGITS[bytes[i] & 0xF];
+    }
+    out[ASCII_COLUMN] = '|';
+    for (size_t i = 0; i < count; ++i) {
+        out[ASCII_COLUMN + 1 + i] = (bytes[i] >= 32 && bytes[i] <= 126) ? static_cast<char>(bytes[i]) : '.';
+    }
+    out[ASCII_COLUMN + 1 + count] = '|';
+    out.resize(ASCII_COLUMN + 2 + count);
+}
+
+const std::string& HexView::GetLine(size_t line) {
+    CachedLine& cached = lineCache[line % lineCache.size()];
+    if (cached.line != line) {
+        FormatLine(line, cached.text);
+        cached.line = line;
+    }
+    return cached.text;
+}
+
+void HexView::GoTo(size_t offset) {
+    if (!data || data->empty()) return;
+    offset = std::min(offset, data->size() - 1);
+    Select(offset, 1);
+}
+
+void HexView::Select(size_t offset, size_t length) {
+    selectionStart = offset;
+    selectionLength = length;
+    pendingScrollLine = offset / BYTES_PER_LINE;
+}
+
+bool HexView::BuildSearchPattern(std::vector<uint8_t>& pattern) const {
+    pattern.clear();
+    if (!searchHex) {
+        for (const char* c = searchBuffer; *c; ++c) {
+            pattern.push_back(static_cast<uint8_t>(*c));
+        }
+        return !pattern.empty();
+    }
+
+    // Hex digits, optionally separated by spaces: "DE AD BEEF"
+    return ResourceSearch::ParseHexPattern(searchBuffer, pattern);
+}
+
+bool HexView::FindNext() {
+    std::vector<uint8_t> pattern;
+    if (!data || !BuildSearchPattern(pattern)) {
+        searchStatus = "Invalid search pattern";
+        return false;
+    }
+
+    auto equal = [this](uint8_t a, uint8_t b) {
+        if (searchHex || !searchIgnoreCase) return a == b;
+        return std::tolower(a) == std::tolower(b);
+    };
+
+    // Start just after the current selection and wrap around once
+    size_t from = selectionLength > 0 ? selectionStart + 1 : 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        auto begin = data->begin() + std::min(from, data->size());
+        auto it = std::search(begin, data->end(), pattern.begin(), pattern.end(), equal);
+        if (it != data->end()) {
+            size_t offset = static_cast<size_t>(it - data->begin());
+            Select(offset, pattern.size());
+            char status[64];
+            std::snprintf(status, sizeof(status), "Found at 0x%zX%s", offset, pass == 1 ? " (wrapped)" : "");
+            searchStatus = status;
+            return true;
+        }
+        from = 0;
+    }
+    searchStatus = "Not found";
+    return false;
+}
+
+void HexView::RenderToolbar() {
+    ImGui::SetNextItemWidth(ImGui::CalcTextSize("00000000").x + ImGui::GetStyle().FramePadding.x * 2);
+    if (ImGui::InputTextWithHint("##goto", "offset", gotoBuffer, sizeof(gotoBuffer),
+                                 ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_EnterReturnsTrue)) {
+        GoTo(std::strtoull(gotoBuffer, nullptr, 16));
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Go")) {
+        GoTo(std::strtoull(gotoBuffer, nullptr, 16));
+    }
+
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(200);
+    if (ImGui::InputTextWithHint("##search", searchHex ? "DE AD BE EF" : "text", searchBuffer, sizeof(searchBuffer),
+                                 ImGuiInputTextFlags_EnterReturnsTrue)) {
+        FindNext();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Find Next")) {
+        FindNext();
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Hex", &searchHex);
+    if (!searchHex) {
+        ImGui::SameLine();
+        ImGui::Checkbox("Ignore case", &searchIgnoreCase);
+    }
+
+    if (selectionLength > 0) {
+        ImGui::Text("Selection: 0x%zX-0x%zX (%zu bytes)", selectionStart, selectionStart + selectionLength - 1, selectionLength);
+    } else {
+        ImGui::Text("Size: %zu bytes", data->size());
+    }
+    if (!searchStatus.empty()) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("%s", searchStatus.c_str());
+    }
+}
+
+void HexView::HandleClick(size_t line, float mouseX, float lineStartX, float charWidth) {
+    size_t column = static_cast<size_t>(std::max(0.0f, mouseX - lineStartX) / charWidth);
+    size_t byteInLine;
+    if (column >= HEX_COLUMN && column < HEX_COLUMN + BYTES_PER_LINE * 3) {
+        byteInLine = (column - HEX_COLUMN) / 3;
+    } else if (column > ASCII_COLUMN && column <= ASCII_COLUMN + BYTES_PER_LINE) {
+        byteInLine = column - ASCII_COLUMN - 1;
+    } else {
+        return;
+    }
+
+    size_t offset = line * BYTES_PER_LINE + byteInLine;
+    if (offset >= data->size()) return;
+
+    if (ImGui::GetIO().KeyShift && selectionLength > 0) {
+        // Extend from the selection anchor
+        size_t anchor = selectionStart;
+        selectionStart = std::min(anchor, offset);
+        selectionLength = std::max(anchor, offset) - selectionStart + 1;
+    } else {
+        selectionStart = offset;
+        selectionLength = 1;
+    }
+}
+
+void HexView::Render(const char* id, float height) {
+    if (!data || data->empty()) {
+        ImGui::Text("(No data)");
+        return;
+    }
+
+    ImGui::PushID(id);
+    RenderToolbar();
+
+    ImGui::BeginChild("##hexlines", ImVec2(0, height), true, ImGuiWindowFlags_HorizontalScrollbar);
+
+    const size_t lineCount = (data->size() + BYTES_PER_LINE - 1) / BYTES_PER_LINE;
+    const float lineHeight = ImGui::GetTextLineHeightWithSpacing();
+    const float charWidth = ImGui::CalcTextSize("0").x;
+
+    if (pendingScrollLine != SIZE_MAX) {
+        // Centre the target line
+        float target = pendingScrollLine * lineHeight - (ImGui::GetWindowSize().y - lineHeight) * 0.5f;
+        ImGui::SetScrollY(std::max(0.0f, target));
+        pendingScrollLine = SIZE_MAX;
+    }
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    const ImU32 selectionColor = ImGui::GetColorU32(ImGuiCol_TextSelectedBg);
+    const size_t selectionEnd = selectionStart + selectionLength;
+
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(lineCount), lineHeight);
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const size_t line = static_cast<size_t>(row);
+            const size_t lineStart = line * BYTES_PER_LINE;
+            const ImVec2 pos = ImGui::GetCursorScreenPos();
+
+            // Selection highlight behind both the hex and ASCII columns
+            if (selectionLength > 0 && selectionStart < lineStart + BYTES_PER_LINE && selectionEnd > lineStart) {
+                size_t first = std::max(selectionStart, lineStart) - lineStart;
+                size_t last = std::min(selectionEnd, lineStart + BYTES_PER_LINE) - lineStart;
+                float y1 = pos.y + ImGui::GetTextLineHeight();
+                drawList->AddRectFilled(ImVec2(pos.x + (HEX_COLUMN + first * 3) * charWidth, pos.y),
+                                        ImVec2(pos.x + (HEX_COLUMN + last * 3 - 1) * charWidth, y1), selectionColor);
+                drawList->AddRectFilled(ImVec2(pos.x + (ASCII_COLUMN + 1 + first) * charWidth, pos.y),
+                                        ImVec2(pos.x + (ASCII_COLUMN + 1 + last) * charWidth, y1), selectionColor);
+            }
+
+            const std::string& text = GetLine(line);
+            ImGui::TextUnformatted(text.data(), text.data() + text.size());
+            if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
+                HandleClick(line, ImGui::GetIO().MousePos.x, pos.x, charWidth);
+            }
+        }
+    }
+    clipper.End();
+
+    ImGui::EndChild();
+    ImGui::PopID();
+}
@@ -0,0 +1,87 @@
+#include "LogBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+LogBuffer::LogBuffer(size_t maxLines, size_t arenaBytes)
+    : arena(std::max(arenaBytes, MAX_LINE_BYTES)), records(std::max<size_t>(maxLines, 1)) {
+}
+
+void LogBuffer::Append(std::string_view text, LogLevel level) {
+    size_t lineStart = 0;
+    for (;;) {
+        size_t newline = text.find('\n', lineStart);
+        std::string_view line = text.substr(lineStart, newline == std::string_view::npos ? std::string_view::npos : newline - lineStart);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        AppendLine(line, level);
+        if (newline == std::string_view::npos || newline + 1 == text.size()) break;
+        lineStart = newline + 1;
+    }
+}
+
+void LogBuffer::AppendLine(std::string_view line, LogLevel level) {
+    const size_t length = std::min(line.size(), MAX_LINE_BYTES);
+    const size_t size = arena.size();
+
+    // Lines are contiguous in the arena: skip the tail if this one would wrap
+    uint64_t start = end;
+    if (start % size + length > size) start += size - start % size;
+    end = start + length;
+
+    // Drop the oldest lines whose bytes are about to be overwritten, or to free a record
+    while (count > 0 && (records[first].start + size < end || count == records.size())) {
+        first = (first + 1) % records.size();
+        count--;
+    }
+
+    if (length > 0) std::memcpy(arena.data() + start % size, line.data(), length);
+    records[(first + count) % records.size()] = {start, static_cast<uint32_t>(length), level};
+    count++;
+    totalAppended++;
+}
+
+void LogBuffer::Clear() {
+    first = 0;
+    count = 0;
+    end = 0;
+}
+
+LogBuffer::Line LogBuffer::operator[](size_t index) const {
+    const Record& record = records[(first + index) % records.size()];
+    return {std::string_view(arena.data() + record.start % arena.size(), record.length), record.level};
+}
+
+LogMirror::~LogMirror() {
+    Flush();
+    if (file) std::fclose(file);
+}
+
+bool LogMirror::SetFile(const std::string& filename) {
+    Flush();
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    if (filename.empty()) return true;
+    file = std::fopen(filename.c_str(), "ab");
+    return file != nullptr;
+}
+
+void LogMirror::Write(std::string_view line) {
+    if (!toStdout && !file) return;
+    pending.append(line);
+    pending += '\n';
+    if (pending.size() >= FLUSH_THRESHOLD) Flush();
+}
+
+void LogMirror::Flush() {
+    if (pending.empty()) return;
+    if (toStdout) {
+        std::fwrite(pending.data(), 1, pending.size(), stdout);
+        std::fflush(stdout);
+    }
+    if (file) {
+        std::fwrite(pending.data(), 1, pending.size(), file);
+        std::fflush(file);
+    }
+    pending.clear();
+}
@@ -0,0 +1,58 @@
+#include "LogQueue.h"
+
+LogQueue::~LogQueue() {
+    Node* node = head.exchange(nullptr);
+    while (node) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+void LogQueue::Push(LogLevel level, std::string source, std::string message) {
+    // A flood from a runaway worker should not exhaust memory between frames
+    if (pending.fetch_add(1, std::memory_order_relaxed) >= MAX_PENDING) {
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Node* node = new Node;
+    node->record.level = level;
+    node->record.source = std::move(source);
+    node->record.message = std::move(message);
+    node->record.time = std::chrono::system_clock::now();
+
+    Node* expected = head.load(std::memory_order_relaxed);
+    do {
+        node->next = expected;
+    } while (!head.compare_exchange_weak(expected, node, std::memory_order_release, std::memory_order_relaxed));
+
+    if (!expected && onFirstPush) onFirstPush();
+}
+
+size_t LogQueue::Drain(std::vector<LogRecord>& out) {
+    Node* node = head.exchange(nullptr, std::memory_order_acquire);
+    if (!node) return 0;
+
+    // The list is newest first; reverse it to get push order
+    Node* reversed = nullptr;
+    size_t count = 0;
+    while (node) {
+        Node* next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+        count++;
+    }
+    pending.fetch_sub(count, std::memory_order_relaxed);
+
+    out.reserve(out.size() + count);
+    while (reversed) {
+        Node* next = reversed->next;
+        out.push_back(std::move(reversed->record));
+        delete reversed;
+        reversed = next;
+    }
+    return count;
+}
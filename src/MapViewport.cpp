@@ -0,0 +1,115 @@
+#include "MapViewport.h"
+#include "GpuTexture.h"
+#include <algorithm>
+#include <cmath>
+
+void MapViewport::Begin(const char* id, float contentWidth, float contentHeight) {
+    contentSize = ImVec2(contentWidth, contentHeight);
+
+    ImGui::BeginChild(id, ImVec2(0, 0), true, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
+    origin = ImGui::GetCursorScreenPos();
+    viewSize = ImGui::GetContentRegionAvail();
+    viewSize.x = std::max(viewSize.x, 1.0f);
+    viewSize.y = std::max(viewSize.y, 1.0f);
+
+    if (fitPending) {
+        FitToView();
+    }
+
+    // Covers the view so drags are captured here rather than moving the window
+    ImGui::InvisibleButton("##viewport", viewSize, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonMiddle);
+    hovered = ImGui::IsItemHovered();
+
+    ImGuiIO& io = ImGui::GetIO();
+    if (ImGui::IsItemActive() && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f)) {
+        pan.x -= io.MouseDelta.x / zoom;
+        pan.y -= io.MouseDelta.y / zoom;
+        ClampPan();
+    }
+    if (hovered && io.MouseWheel != 0.0f) {
+        ZoomAround(zoom * std::pow(ZOOM_STEP, io.MouseWheel), io.MousePos);
+    }
+    if (hovered) {
+        hoverContentPos = ImVec2(pan.x + (io.MousePos.x - origin.x) / zoom,
+                                 pan.y + (io.MousePos.y - origin.y) / zoom);
+    }
+
+    ImGui::GetWindowDrawList()->PushClipRect(origin, ImVec2(origin.x + viewSize.x, origin.y + viewSize.y), true);
+}
+
+void MapViewport::End() {
+    ImGui::GetWindowDrawList()->PopClipRect();
+    ImGui::EndChild();
+}
+
+void MapViewport::SetZoom(float newZoom) {
+    ZoomAround(newZoom, ImVec2(origin.x + viewSize.x * 0.5f, origin.y + viewSize.y * 0.5f));
+}
+
+void MapViewport::FitToView() {
+    fitPending = false;
+    if (contentSize.x <= 0 || contentSize.y <= 0) return;
+    zoom = std::clamp(std::min(viewSize.x / contentSize.x, viewSize.y / contentSize.y), MIN_ZOOM, MAX_ZOOM);
+    pan = ImVec2(0, 0);
+    ClampPan();
+}
+
+void MapViewport::ZoomAround(float newZoom, ImVec2 screenAnchor) {
+    newZoom = std::clamp(newZoom, MIN_ZOOM, MAX_ZOOM);
+    // Keep the content point under the anchor fixed on screen
+    float ax = pan.x + (screenAnchor.x - origin.x) / zoom;
+    float ay = pan.y + (screenAnchor.y - origin.y) / zoom;
+    zoom = newZoom;
+    pan.x = ax - (screenAnchor.x - origin.x) / zoom;
+    pan.y = ay - (screenAnchor.y - origin.y) / zoom;
+    ClampPan();
+}
+
+void MapViewport::ClampPan() {
+    // Allow panning until the content edge reaches the middle of the view
+    float halfW = viewSize.x * 0.5f / zoom;
+    float halfH = viewSize.y * 0.5f / zoom;
+    pan.x = std::clamp(pan.x, -halfW, std::max(-halfW, contentSize.x - halfW));
+    pan.y = std::clamp(pan.y, -halfH, std::max(-halfH, contentSize.y - halfH));
+}
+
+ImVec2 MapViewport::ContentToScreen(float x, float y) const {
+    return ImVec2(std::floor(origin.x + (x - pan.x) * zoom), std::floor(origin.y + (y - pan.y) * zoom));
+}
+
+void MapViewport::GetVisibleCells(uint32_t gridWidth, uint32_t gridHeight, uint32_t tileSize,
+                                  uint32_t& x0, uint32_t& y0, uint32_t& x1, uint32_t& y1) const {
+    float left = std::max(pan.x, 0.0f);
+    float top = std::max(pan.y, 0.0f);
+    float right = pan.x + viewSize.x / zoom;
+    float bottom = pan.y + viewSize.y / zoom;
+
+    x0 = std::min(gridWidth, static_cast<uint32_t>(left / tileSize));
+    y0 = std::min(gridHeight, static_cast<uint32_t>(top / tileSize));
+    x1 = right <= 0 ? 0 : std::min(gridWidth, static_cast<uint32_t>(std::ceil(right / tileSize)));
+    y1 = bottom <= 0 ? 0 : std::min(gridHeight, static_cast<uint32_t>(std::ceil(bottom / tileSize)));
+}
+
+void MapViewport::DrawTiles(const GpuTexture& atlas, uint32_t atlasColumns, const uint8_t* cells,
+                            uint32_t gridWidth, uint32_t gridHeight, uint32_t tileSize) {
+    if (!atlas.IsValid() || !cells || atlasColumns == 0) return;
+
+    uint32_t x0, y0, x1, y1;
+    GetVisibleCells(gridWidth, gridHeight, tileSize, x0, y0, x1, y1);
+
+    const float uvStepX = static_cast<float>(tileSize) / atlas.GetWidth();
+    const float uvStepY = static_cast<float>(tileSize) / atlas.GetHeight();
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+    for (uint32_t row = y0; row < y1; ++row) {
+        const uint8_t* rowCells = cells + static_cast<size_t>(row) * gridWidth;
+        for (uint32_t col = x0; col < x1; ++col) {
+            uint8_t tile = rowCells[col];
+            float u = (tile % atlasColumns) * uvStepX;
+            float v = (tile / atlasColumns) * uvStepY;
+            ImVec2 p0 = ContentToScreen(static_cast<float>(col * tileSize), static_cast<float>(row * tileSize));
+            ImVec2 p1 = ContentToScreen(static_cast<float>((col + 1) * tileSize), static_cast<float>((row + 1) * tileSize));
+            drawList->AddImage(atlas.GetID(), p0, p1, ImVec2(u, v), ImVec2(u + uvStepX, v + uvStepY));
+        }
+    }
+}
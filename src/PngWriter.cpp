@@ -0,0 +1,164 @@
+#include "PngWriter.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+#ifdef WIME_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+void PutBigEndian32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Length, type, data, CRC over type + data
+void PutChunk(std::vector<uint8_t>& out, const char type[4], const uint8_t* data, size_t size) {
+    PutBigEndian32(out, static_cast<uint32_t>(size));
+    size_t typeStart = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (size > 0) out.insert(out.end(), data, data + size);
+    PutBigEndian32(out, PngWriter::Crc32(out.data() + typeStart, size + 4));
+}
+
+#ifndef WIME_HAVE_ZLIB
+uint32_t Adler32(const uint8_t* data, size_t size) {
+    constexpr uint32_t MOD_ADLER = 65521;
+    constexpr size_t BLOCK = 5552;  // Largest run before the sums can overflow 32 bits
+    uint32_t a = 1, b = 0;
+    while (size > 0) {
+        size_t n = std::min(size, BLOCK);
+        size -= n;
+        while (n--) {
+            a += *data++;
+            b += a;
+        }
+        a %= MOD_ADLER;
+        b %= MOD_ADLER;
+    }
+    return (b << 16) | a;
+}
+
+// zlib stream made of stored deflate blocks (no compression)
+std::vector<uint8_t> StoreZlib(const std::vector<uint8_t>& raw) {
+    constexpr size_t MAX_STORED_BLOCK = 65535;
+    std::vector<uint8_t> out;
+    out.reserve(raw.size() + (raw.size() / MAX_STORED_BLOCK + 1) * 5 + 6);
+    out.push_back(0x78);
+    out.push_back(0x01);
+    size_t position = 0;
+    do {
+        size_t length = std::min(raw.size() - position, MAX_STORED_BLOCK);
+        bool last = position + length == raw.size();
+        out.push_back(last ? 1 : 0);
+        out.push_back(static_cast<uint8_t>(length));
+        out.push_back(static_cast<uint8_t>(length >> 8));
+        out.push_back(static_cast<uint8_t>(~length));
+        out.push_back(static_cast<uint8_t>(~length >> 8));
+        out.insert(out.end(), raw.begin() + position, raw.begin() + position + length);
+        position += length;
+    } while (position < raw.size());
+    PutBigEndian32(out, Adler32(raw.data(), raw.size()));
+    return out;
+}
+#endif
+
+}  // namespace
+
+uint32_t PngWriter::Crc32(const uint8_t* data, size_t size, uint32_t crc) {
+#ifdef WIME_HAVE_ZLIB
+    return static_cast<uint32_t>(crc32(crc, data, static_cast<uInt>(size)));
+#else
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+#endif
+}
+
+std::vector<uint8_t> PngWriter::EncodeIndexed(const IndexedImage& image, const uint32_t* palette, size_t paletteSize,
+                                              int compressionLevel) {
+    paletteSize = std::min(paletteSize, MAX_PALETTE_SIZE);
+
+    // Scanlines with filter type 0 (None): indexed data rarely benefits from filtering
+    std::vector<uint8_t> raw;
+    raw.reserve(static_cast<size_t>(image.width + 1) * image.height);
+    for (uint32_t y = 0; y < image.height; ++y) {
+        raw.push_back(0);
+        const uint8_t* row = image.pixels.data() + static_cast<size_t>(y) * image.width;
+        raw.insert(raw.end(), row, row + image.width);
+    }
+
+    std::vector<uint8_t> compressed;
+#ifdef WIME_HAVE_ZLIB
+    uLongf compressedSize = compressBound(static_cast<uLong>(raw.size()));
+    compressed.resize(compressedSize);
+    if (compress2(compressed.data(), &compressedSize, raw.data(), static_cast<uLong>(raw.size()),
+                  std::clamp(compressionLevel, 0, 9)) != Z_OK) {
+        return {};
+    }
+    compressed.resize(compressedSize);
+#else
+    (void)compressionLevel;
+    compressed = StoreZlib(raw);
+#endif
+
+    std::vector<uint8_t> png;
+    png.reserve(compressed.size() + paletteSize * 3 + 64);
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png.insert(png.end(), signature, signature + 8);
+
+    std::vector<uint8_t> header;
+    PutBigEndian32(header, image.width);
+    PutBigEndian32(header, image.height);
+    header.insert(header.end(), {8, 3, 0, 0, 0});  // 8-bit depth, indexed, deflate, filter 0, no interlace
+    PutChunk(png, "IHDR", header.data(), header.size());
+
+    std::vector<uint8_t> plte;
+    for (size_t i = 0; i < paletteSize; ++i) {
+        plte.push_back(static_cast<uint8_t>(palette[i]));
+        plte.push_back(static_cast<uint8_t>(palette[i] >> 8));
+        plte.push_back(static_cast<uint8_t>(palette[i] >> 16));
+    }
+    PutChunk(png, "PLTE", plte.data(), plte.size());
+    PutChunk(png, "IDAT", compressed.data(), compressed.size());
+    PutChunk(png, "IEND", nullptr, 0);
+    return png;
+}
+
+bool PngWriter::WriteIndexed(const std::string& filename, const IndexedImage& image, const uint32_t* palette,
+                             size_t paletteSize, int compressionLevel, std::string& error) {
+    if (image.width == 0 || image.height == 0 || image.pixels.size() < static_cast<size_t>(image.width) * image.height) {
+        error = "Empty image";
+        return false;
+    }
+    std::vector<uint8_t> png = EncodeIndexed(image, palette, paletteSize, compressionLevel);
+    if (png.empty()) {
+        error = "PNG compression failed";
+        return false;
+    }
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+    if (!out) {
+        error = "Cannot write " + filename;
+        return false;
+    }
+    return true;
+}
@@ -16,6 +16,8 @@ void PreviewWindow::SetResource(const std::shared_ptr<ResourceItem>& resource, c
         if (viewer) {
             viewer->SetResource(resource);
             viewer->SetGameFilePath(gameFilePath);
+            viewer->SetResourceIndex(resourceIndex);
+            viewer->SetResourceEdits(resourceEdits);
         }
     } else {
         viewer.reset();
@@ -24,6 +26,18 @@ void PreviewWindow::SetResource(const std::shared_ptr<ResourceItem>& resource, c
 
 PreviewWindow::~PreviewWindow() = default;
 
+void PreviewWindow::Refresh() {
+    if (viewer) {
+        viewer->ClearCache();
+    }
+}
+
+void PreviewWindow::GoToOffset(size_t offset, size_t length) {
+    if (viewer) {
+        viewer->GoToOffset(offset, length);
+    }
+}
+
 std::string PreviewWindow::GetTitle() const {
     if (!resource) return "Preview";
     std::ostringstream oss;
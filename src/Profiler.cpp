@@ -0,0 +1,226 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+std::atomic<bool> Profiler::enabled{false};
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t startNs;
+    uint64_t durationNs;
+    uint64_t frame;
+    uint32_t thread;
+};
+
+struct Frame {
+    uint64_t number;
+    uint64_t startNs;
+    uint64_t durationNs;
+};
+
+// Ring buffers, allocated the first time the profiler is enabled
+struct State {
+    std::mutex mutex;
+    std::vector<Event> events;
+    size_t nextEvent = 0;
+    size_t eventCount = 0;
+    std::vector<Frame> frames;
+    size_t nextFrame = 0;
+    size_t frameCount = 0;
+    uint64_t currentFrame = 0;
+    uint64_t frameStart = 0;
+};
+
+State& GetState() {
+    static State state;
+    return state;
+}
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+// Small stable IDs read better in trace viewers than hashed thread IDs
+uint32_t ThreadNumber() {
+    static std::atomic<uint32_t> nextThread{1};
+    thread_local uint32_t number = nextThread++;
+    return number;
+}
+
+template <typename T, typename F>
+void ForEachInRing(const std::vector<T>& ring, size_t next, size_t count, F visit) {
+    for (size_t i = 0; i < count; ++i) {
+        visit(ring[(next + ring.size() - count + i) % ring.size()]);
+    }
+}
+
+void AppendEscaped(std::string& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out += '\\';
+        out += *c;
+    }
+}
+
+}  // namespace
+
+void Profiler::SetEnabled(bool enable) {
+    if (enable == IsEnabled()) return;
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (enable && state.events.empty()) {
+        state.events.resize(EVENT_CAPACITY);
+        state.frames.resize(FRAME_CAPACITY);
+    }
+    // A frame that straddles the switch would be measured wrongly, so start afresh
+    state.frameStart = 0;
+    enabled = enable;
+}
+
+uint64_t Profiler::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count()) + 1;
+}
+
+void Profiler::BeginFrame() {
+    if (!IsEnabled()) return;
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.frameStart = Now();
+}
+
+void Profiler::EndFrame() {
+    if (!IsEnabled()) return;
+    uint64_t end = Now();
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.frameStart != 0) {
+        state.frames[state.nextFrame] = {state.currentFrame, state.frameStart, end - state.frameStart};
+        state.nextFrame = (state.nextFrame + 1) % state.frames.size();
+        state.frameCount = std::min(state.frameCount + 1, state.frames.size());
+    }
+    state.frameStart = 0;
+    state.currentFrame++;
+}
+
+void Profiler::Record(const char* name, uint64_t startNs, uint64_t endNs) {
+    uint32_t thread = ThreadNumber();
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.events.empty()) return;
+    state.events[state.nextEvent] = {name, startNs, endNs - startNs, state.currentFrame, thread};
+    state.nextEvent = (state.nextEvent + 1) % state.events.size();
+    state.eventCount = std::min(state.eventCount + 1, state.events.size());
+}
+
+std::vector<float> Profiler::GetFrameTimes() {
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    std::vector<float> times;
+    times.reserve(state.frameCount);
+    ForEachInRing(state.frames, state.nextFrame, state.frameCount, [&](const Frame& frame) {
+        times.push_back(frame.durationNs / 1e6f);
+    });
+    return times;
+}
+
+std::vector<Profiler::ScopeStats> Profiler::GetScopeStats() {
+    struct FrameTotal {
+        uint64_t frame;
+        uint64_t ns;
+        size_t calls;
+    };
+    // Events are in frame order, so each scope's per-frame totals are built by appending
+    std::unordered_map<const char*, std::vector<FrameTotal>> totals;
+    {
+        State& state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.frameCount == 0) return {};
+        // Only frames that are complete and whose events have not been overwritten
+        uint64_t firstFrame = state.frames[(state.nextFrame + state.frames.size() - state.frameCount) % state.frames.size()].number;
+        if (state.eventCount == state.events.size()) {
+            firstFrame = std::max(firstFrame, state.events[state.nextEvent].frame + 1);
+        }
+        ForEachInRing(state.events, state.nextEvent, state.eventCount, [&](const Event& event) {
+            if (event.frame < firstFrame || event.frame >= state.currentFrame) return;
+            auto& frames = totals[event.name];
+            if (frames.empty() || frames.back().frame != event.frame) frames.push_back({event.frame, 0, 0});
+            frames.back().ns += event.durationNs;
+            frames.back().calls++;
+        });
+    }
+
+    std::vector<ScopeStats> stats;
+    std::vector<double> perFrame;
+    for (const auto& [name, frames] : totals) {
+        ScopeStats scope;
+        scope.name = name;
+        scope.frames = frames.size();
+        perFrame.clear();
+        size_t calls = 0;
+        for (const FrameTotal& total : frames) {
+            perFrame.push_back(total.ns / 1e6);
+            scope.averageMs += total.ns / 1e6;
+            calls += total.calls;
+        }
+        scope.averageMs /= perFrame.size();
+        scope.callsPerFrame = static_cast<double>(calls) / perFrame.size();
+        size_t p99 = std::min(perFrame.size() - 1, perFrame.size() * 99 / 100);
+        std::nth_element(perFrame.begin(), perFrame.begin() + p99, perFrame.end());
+        scope.p99Ms = perFrame[p99];
+        scope.maxMs = *std::max_element(perFrame.begin(), perFrame.end());
+        stats.push_back(std::move(scope));
+    }
+    std::sort(stats.begin(), stats.end(), [](const ScopeStats& a, const ScopeStats& b) {
+        return a.averageMs > b.averageMs;
+    });
+    return stats;
+}
+
+void Profiler::Clear() {
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.nextEvent = state.eventCount = 0;
+    state.nextFrame = state.frameCount = 0;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& filename, std::string& error) {
+    // Copy out under the lock, format without it
+    std::vector<Event> events;
+    std::vector<Frame> frames;
+    {
+        State& state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        ForEachInRing(state.events, state.nextEvent, state.eventCount, [&](const Event& event) { events.push_back(event); });
+        ForEachInRing(state.frames, state.nextFrame, state.frameCount, [&](const Frame& frame) { frames.push_back(frame); });
+    }
+
+    std::string json = "{\"traceEvents\":[\n";
+    char buffer[128];
+    bool first = true;
+    auto append = [&](const char* name, uint64_t startNs, uint64_t durationNs, uint32_t thread) {
+        if (!first) json += ",\n";
+        first = false;
+        json += "{\"name\":\"";
+        AppendEscaped(json, name);
+        std::snprintf(buffer, sizeof(buffer), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                      thread, startNs / 1e3, durationNs / 1e3);
+        json += buffer;
+    };
+    // Frames on the main thread's track, so scopes nest under them
+    uint32_t mainThread = ThreadNumber();
+    for (const Frame& frame : frames) append("Frame", frame.startNs, frame.durationNs, mainThread);
+    for (const Event& event : events) append(event.name, event.startNs, event.durationNs, event.thread);
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(json.data(), static_cast<std::streamsize>(json.size()));
+    if (!out) {
+        error = "Cannot write " + filename;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+#include "ProfilerWindow.h"
+#include "FrameScheduler.h"
+#include <imgui.h>
+#include <algorithm>
+#include <cstdio>
+
+void ProfilerWindow::Render(bool* open) {
+    if (!ImGui::Begin("Profiler", open)) {
+        // Collapsed or docked out of sight: stop recording
+        Profiler::SetEnabled(false);
+        ImGui::End();
+        return;
+    }
+    Profiler::SetEnabled(!paused);
+    // Frame times are only meaningful if frames keep coming
+    if (!paused) FrameScheduler::RequestContinuous();
+
+    auto now = std::chrono::steady_clock::now();
+    if (!paused && now - lastRefresh >= REFRESH_INTERVAL) {
+        lastRefresh = now;
+        frameTimes = Profiler::GetFrameTimes();
+        scopeStats = Profiler::GetScopeStats();
+    }
+
+    ImGui::Checkbox("Pause", &paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) {
+        Profiler::Clear();
+        frameTimes.clear();
+        scopeStats.clear();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Save Chrome Trace...") && onSaveTrace) {
+        onSaveTrace();
+    }
+
+    if (!frameTimes.empty()) {
+        float average = 0.0f;
+        for (float ms : frameTimes) average += ms;
+        average /= frameTimes.size();
+        float worst = *std::max_element(frameTimes.begin(), frameTimes.end());
+        char overlay[64];
+        std::snprintf(overlay, sizeof(overlay), "avg %.2f ms (%.0f fps), max %.2f ms",
+                      average, average > 0.0f ? 1000.0f / average : 0.0f, worst);
+        ImGui::PlotLines("##frames", frameTimes.data(), static_cast<int>(frameTimes.size()), 0, overlay,
+                         0.0f, std::max(worst, 1000.0f / 30.0f), ImVec2(-1.0f, 80.0f));
+    } else {
+        ImGui::TextDisabled("Collecting frames...");
+    }
+
+    // Times are per frame the scope ran in; nested scopes are included in their parents
+    if (ImGui::BeginTable("Scopes", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY |
+                                       ImGuiTableFlags_Resizable)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Scope");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("p99 ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableSetupColumn("Calls/frame");
+        ImGui::TableHeadersRow();
+        for (const auto& scope : scopeStats) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(scope.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.averageMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.p99Ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.maxMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", scope.callsPerFrame);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
@@ -35,6 +35,13 @@ void PropertiesWindow::SetGameFilePath(const std::string& filePath) {
     }
 }
 
+void PropertiesWindow::SetResourceIndex(const ResourceIndex* index) {
+    resourceIndex = index;
+    if (currentViewer) {
+        currentViewer->SetResourceIndex(index);
+    }
+}
+
 void PropertiesWindow::ClearSelection() {
     selectedResource = nullptr;
     hasSelection = false;
@@ -47,6 +54,12 @@ void PropertiesWindow::RenderResourceProperties() {
     RenderResourceDetails();
 }
 
+void PropertiesWindow::Refresh() {
+    if (currentViewer) {
+        currentViewer->ClearCache();
+    }
+}
+
 void PropertiesWindow::UpdateViewer() {
     if (!selectedResource) {
         currentViewer.reset();
@@ -58,6 +71,7 @@ void PropertiesWindow::UpdateViewer() {
     if (currentViewer) {
         currentViewer->SetResource(selectedResource);
         currentViewer->SetGameFilePath(gameFilePath);
+        currentViewer->SetResourceIndex(resourceIndex);
     }
 }
 
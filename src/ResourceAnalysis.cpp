@@ -0,0 +1,172 @@
+#include "ResourceAnalysis.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WIME_HAVE_SSE2 1
+#endif
+
+std::unordered_map<std::string, std::shared_ptr<const ByteStatistics>> ResourceAnalysis::cache;
+
+void ResourceAnalysis::ComputeHistogram(const uint8_t* data, size_t size, uint64_t* histogram) {
+    // Four interleaved sub-histograms so runs of the same byte do not serialise on
+    // one counter's load/store; eight bytes are fetched per load and split in registers.
+    // Blocks of HISTOGRAM_BLOCK bytes keep the 32-bit sub-histogram sums from overflowing.
+    alignas(16) uint32_t sub[4][256];
+    alignas(16) uint32_t blockTotal[256];
+    for (size_t blockStart = 0; blockStart < size; blockStart += HISTOGRAM_BLOCK) {
+        const uint8_t* block = data + blockStart;
+        const size_t blockSize = std::min(HISTOGRAM_BLOCK, size - blockStart);
+        std::memset(sub, 0, sizeof(sub));
+
+        size_t i = 0;
+        for (; i + 8 <= blockSize; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, block + i, sizeof(word));
+            sub[0][word & 0xFF]++;
+            sub[1][(word >> 8) & 0xFF]++;
+            sub[2][(word >> 16) & 0xFF]++;
+            sub[3][(word >> 24) & 0xFF]++;
+            sub[0][(word >> 32) & 0xFF]++;
+            sub[1][(word >> 40) & 0xFF]++;
+            sub[2][(word >> 48) & 0xFF]++;
+            sub[3][word >> 56]++;
+        }
+        for (; i < blockSize; ++i) {
+            sub[0][block[i]]++;
+        }
+
+        // Reduce the sub-histograms four bins at a time, then widen into the 64-bit bins
+#ifdef WIME_HAVE_SSE2
+        for (size_t bin = 0; bin < 256; bin += 4) {
+            __m128i sum = _mm_load_si128(reinterpret_cast<const __m128i*>(&sub[0][bin]));
+            sum = _mm_add_epi32(sum, _mm_load_si128(reinterpret_cast<const __m128i*>(&sub[1][bin])));
+            sum = _mm_add_epi32(sum, _mm_load_si128(reinterpret_cast<const __m128i*>(&sub[2][bin])));
+            sum = _mm_add_epi32(sum, _mm_load_si128(reinterpret_cast<const __m128i*>(&sub[3][bin])));
+            _mm_store_si128(reinterpret_cast<__m128i*>(&blockTotal[bin]), sum);
+        }
+#else
+        for (size_t bin = 0; bin < 256; ++bin) {
+            blockTotal[bin] = sub[0][bin] + sub[1][bin] + sub[2][bin] + sub[3][bin];
+        }
+#endif
+        for (size_t bin = 0; bin < 256; ++bin) {
+            histogram[bin] += blockTotal[bin];
+        }
+    }
+}
+
+ByteStatistics ResourceAnalysis::AnalyzeBytes(const uint8_t* data, size_t size) {
+    ByteStatistics stats;
+    stats.totalBytes = size;
+    if (size == 0) return stats;
+
+    ComputeHistogram(data, size, stats.histogram.data());
+    Summarize(stats);
+    return stats;
+}
+
+void ResourceAnalysis::Summarize(ByteStatistics& stats) {
+    stats.uniqueValues = 0;
+    stats.modeValue = 0;
+    stats.modeCount = 0;
+    stats.entropy = 0.0;
+    if (stats.totalBytes == 0) return;
+
+    const double total = static_cast<double>(stats.totalBytes);
+    for (size_t value = 0; value < 256; ++value) {
+        uint64_t count = stats.histogram[value];
+        if (count == 0) continue;
+        stats.uniqueValues++;
+        if (count > stats.modeCount) {
+            stats.modeCount = count;
+            stats.modeValue = static_cast<uint8_t>(value);
+        }
+        double p = count / total;
+        stats.entropy -= p * std::log2(p);
+    }
+}
+
+std::vector<std::pair<uint8_t, uint64_t>> ResourceAnalysis::TopValues(const ByteStatistics& stats, size_t count) {
+    std::vector<std::pair<uint8_t, uint64_t>> values;
+    values.reserve(stats.uniqueValues);
+    for (size_t value = 0; value < 256; ++value) {
+        if (stats.histogram[value] > 0) {
+            values.emplace_back(static_cast<uint8_t>(value), stats.histogram[value]);
+        }
+    }
+    count = std::min(count, values.size());
+    std::partial_sort(values.begin(), values.begin() + count, values.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    values.resize(count);
+    return values;
+}
+
+std::map<std::string, std::unique_ptr<MappedFile>> ResourceAnalysis::MapSourceFiles(const std::vector<std::shared_ptr<ResourceItem>>& items,
+                                                                                     std::vector<std::string>& errors) {
+    std::map<std::string, std::unique_ptr<MappedFile>> files;
+    for (const auto& item : items) {
+        if (item->sourceFile.empty() || files.count(item->sourceFile)) continue;
+        try {
+            files[item->sourceFile] = std::make_unique<MappedFile>(item->sourceFile);
+        } catch (const std::exception& e) {
+            errors.push_back(e.what());
+        }
+    }
+    return files;
+}
+
+bool ResourceAnalysis::ChunkBytes(const MappedFile& file, const ResourceItem& item, const uint8_t*& data, size_t& size) {
+    if (item.offset >= file.Size()) return false;
+    data = file.Data() + item.offset;
+    size = std::min<size_t>(static_cast<size_t>(item.size) + 4, file.Size() - item.offset);
+    return true;
+}
+
+bool ResourceAnalysis::ComputeTypeStatistics(const std::vector<std::shared_ptr<ResourceItem>>& items,
+                                             const std::map<std::string, std::unique_ptr<MappedFile>>& files,
+                                             std::map<std::string, TypeStatistics>& byType,
+                                             AnalysisProgress* progress) {
+    for (const auto& item : items) {
+        if (progress && progress->cancel) return false;
+        TypeStatistics& stats = byType[GetResourceTypeID(item->type)];
+        stats.count++;
+        stats.bytes += item->size;
+        stats.smallest = std::min(stats.smallest, item->size);
+        stats.largest = std::max(stats.largest, item->size);
+
+        auto file = files.find(item->sourceFile);
+        const uint8_t* data;
+        size_t size;
+        if (file != files.end() && ChunkBytes(*file->second, *item, data, size)) {
+            ComputeHistogram(data, size, stats.content.histogram.data());
+            stats.content.totalBytes += size;
+        }
+        if (progress) progress->itemsDone++;
+    }
+    for (auto& entry : byType) Summarize(entry.second.content);
+    return true;
+}
+
+std::shared_ptr<const ByteStatistics> ResourceAnalysis::GetCached(const ResourceItem& item, const char* kind,
+                                                                  const std::vector<uint8_t>& data) {
+    std::string key = item.sourceFile + "@" + std::to_string(item.offset) + "#" + kind;
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        auto stats = std::make_shared<ByteStatistics>(AnalyzeBytes(data.data(), data.size()));
+        it = cache.emplace(std::move(key), std::move(stats)).first;
+    }
+    return it->second;
+}
+
+void ResourceAnalysis::ClearCache() {
+    cache.clear();
+}
+
+void ResourceAnalysis::ClearCache(const std::string& sourceFile) {
+    const std::string prefix = sourceFile + "@";
+    std::erase_if(cache, [&prefix](const auto& entry) { return entry.first.compare(0, prefix.size(), prefix) == 0; });
+}
@@ -17,6 +17,7 @@ void ResourceBrowserWindow::Render() {
                 RenderResourceTab("Characters", ResourceType::CHAR);
                 RenderResourceTab("Strings", ResourceType::CSTR);
                 RenderResourceTab("Fonts", ResourceType::FONT);
+                RenderResourceTab("Forms", ResourceType::FRML);
                 RenderResourceTab("Images", ResourceType::IMAG);
                 RenderResourceTab("Maps", ResourceType::MMAP);
                 ImGui::EndTabBar();
@@ -0,0 +1,264 @@
+#include "ResourceDecoders.h"
+#include "BinaryFile.h"
+#include <algorithm>
+#include <iostream>
+
+const std::array<uint32_t, ResourceDecoders::PALETTE_SIZE>& ResourceDecoders::GetPalette() {
+    // PC VGA tile palette from the VB editor, with its red and green channels swapped
+    // as the original viewer displayed them. Indices 16 and up are black.
+    static const std::array<uint32_t, PALETTE_SIZE> palette = {
+        0xFF000000,  //  0: Black
+        0xFFFF5586,  //  1: Blue
+        0xFF103065,  //  2: Green
+        0xFF557555,  //  3: Brown
+        0xFF86EBAA,  //  4: Light orange
+        0xFFFF00FF,  //  5: Cyan
+        0xFF102041,  //  6: Dark green
+        0xFF556596,  //  7: Light green
+        0xFF868686,  //  8: Gray
+        0xFFFF86BA,  //  9: Light blue
+        0xFF41CB00,  // 10: Red
+        0xFFFFFFFF,  // 11: White
+        0xFFCBDB75,  // 12: Pink
+        0xFF0065BA,  // 13: Bright green
+        0xFFBAEBEB,  // 14: Light yellow
+        0xFFDBFFFF,  // 15: Very light yellow
+        0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000,
+        0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000,
+    };
+    return palette;
+}
+
+uint32_t ResourceDecoders::GetPaletteColor(uint8_t index) {
+    return index < PALETTE_SIZE ? GetPalette()[index] : 0xFF000000;
+}
+
+void ResourceDecoders::ExpandPalette(const IndexedImage& image, std::vector<uint32_t>& rgba) {
+    // Full 256-entry table so the loop needs no bounds check
+    static const std::array<uint32_t, 256> lookup = [] {
+        std::array<uint32_t, 256> table{};
+        for (size_t i = 0; i < table.size(); ++i) {
+            table[i] = GetPaletteColor(static_cast<uint8_t>(i));
+        }
+        return table;
+    }();
+    rgba.resize(image.pixels.size());
+    for (size_t i = 0; i < image.pixels.size(); ++i) {
+        rgba[i] = lookup[image.pixels[i]];
+    }
+}
+
+std::vector<uint8_t> ResourceDecoders::ReadTileData(const std::string& sourceFile, uint32_t offset) {
+    try {
+        BinaryFile file(sourceFile);
+        if (!file.IsOpen()) {
+            return {};
+        }
+        uint32_t dataStartOffset = offset + 4;
+        uint32_t expectedSize = TILE_COUNT * TILE_BYTES;
+        if (dataStartOffset >= file.GetLength()) {
+            return {};
+        }
+        file.SetPosition(dataStartOffset);
+        size_t available = file.GetLength() - dataStartOffset;
+        return file.ReadBytes(std::min<size_t>(expectedSize, available));
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading tile data: " << e.what() << std::endl;
+        return {};
+    }
+}
+
+void ResourceDecoders::DecodeTile(const std::vector<uint8_t>& tileData, size_t tileIndex, uint8_t* out) {
+    size_t tileOffset = tileIndex * TILE_BYTES;
+    if (tileOffset + TILE_BYTES > tileData.size()) {
+        std::fill_n(out, TILE_SIZE * TILE_SIZE, 0);
+        return;
+    }
+
+    // 4bpp, low nibble first
+    const uint8_t* src = tileData.data() + tileOffset;
+    for (size_t i = 0; i < TILE_BYTES; ++i) {
+        out[2 * i] = src[i] & 0x0F;
+        out[2 * i + 1] = (src[i] >> 4) & 0x0F;
+    }
+}
+
+IndexedImage ResourceDecoders::BuildTileAtlas(const std::vector<uint8_t>& tileData) {
+    IndexedImage atlas;
+    atlas.width = atlas.height = ATLAS_SIZE;
+    atlas.pixels.assign(static_cast<size_t>(ATLAS_SIZE) * ATLAS_SIZE, 0);
+
+    uint8_t tile[TILE_SIZE * TILE_SIZE];
+    for (uint32_t tileIndex = 0; tileIndex < TILE_COUNT; ++tileIndex) {
+        DecodeTile(tileData, tileIndex, tile);
+        uint32_t originX = (tileIndex % ATLAS_COLUMNS) * TILE_SIZE;
+        uint32_t originY = (tileIndex / ATLAS_COLUMNS) * TILE_SIZE;
+        for (uint32_t y = 0; y < TILE_SIZE; ++y) {
+            std::copy_n(tile + y * TILE_SIZE, TILE_SIZE, &atlas.pixels[(originY + y) * ATLAS_SIZE + originX]);
+        }
+    }
+    return atlas;
+}
+
+bool ResourceDecoders::ParseMapHeader(const std::vector<uint8_t>& chunk, MapCells& map) {
+    // The grid words follow the platform's data endianness, which the item does not record.
+    // An order is only plausible if the ByteRun stream after the header could fill its grid
+    // (16 = 0x0010 read the wrong way is 4096); if both are, the smaller grid wins.
+    map.headerRecognised = false;
+    if (chunk.size() >= MAP_HEADER_BYTES) {
+        const uint64_t maxCells = static_cast<uint64_t>(chunk.size() - MAP_HEADER_BYTES) * MAX_BYTERUN_EXPANSION;
+        uint64_t bestArea = 0;
+        for (Endianness endian : {Endianness::Little, Endianness::Big}) {
+            uint32_t gridW = static_cast<uint16_t>(BinaryFile::ReadShort(chunk[4], chunk[5], endian));
+            uint32_t gridH = static_cast<uint16_t>(BinaryFile::ReadShort(chunk[6], chunk[7], endian));
+            uint64_t area = static_cast<uint64_t>(gridW) * gridH;
+            if (gridW > 0 && gridH > 0 && gridW <= MAX_GRID_DIMENSION && gridH <= MAX_GRID_DIMENSION &&
+                area <= maxCells && (!map.headerRecognised || area < bestArea)) {
+                map.gridWidth = gridW;
+                map.gridHeight = gridH;
+                map.headerRecognised = true;
+                bestArea = area;
+            }
+        }
+    }
+    if (!map.headerRecognised) {
+        map.gridWidth = DEFAULT_GRID_WIDTH;
+        map.gridHeight = DEFAULT_GRID_HEIGHT;
+    }
+    return map.headerRecognised;
+}
+
+size_t ResourceDecoders::DecodeByteRun(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    size_t readBytes = 0;
+    size_t count = 0;
+    while (readBytes < srcSize && count < dstSize) {
+        int8_t runByte = static_cast<int8_t>(src[readBytes++]);
+        if (runByte >= 0) {
+            // Literal run of runByte+1 bytes
+            size_t run = std::min<size_t>({static_cast<size_t>(runByte) + 1, dstSize - count, srcSize - readBytes});
+            std::copy_n(src + readBytes, run, dst + count);
+            readBytes += run;
+            count += run;
+        } else if (runByte != -128) {
+            // Repeat the next byte -runByte+1 times
+            if (readBytes >= srcSize) break;
+            uint8_t repeatByte = src[readBytes++];
+            size_t run = std::min<size_t>(static_cast<size_t>(-runByte) + 1, dstSize - count);
+            std::fill_n(dst + count, run, repeatByte);
+            count += run;
+        }
+    }
+    return count;
+}
+
+bool ResourceDecoders::ReadMap(const ResourceItem& item, MapCells& map) {
+    map = MapCells();
+    try {
+        if (item.sourceFile.empty() || item.size < MAP_CHUNK_OVERHEAD) {
+            return false;
+        }
+
+        BinaryFile file(item.sourceFile);
+        if (!file.IsOpen() || item.offset + MAP_HEADER_BYTES >= file.GetLength()) {
+            return false;
+        }
+
+        // Header at offset, ByteRun data at offset + 8, compressed size = size - 18
+        size_t compressedSize = item.size - MAP_CHUNK_OVERHEAD;
+        size_t available = file.GetLength() - item.offset;
+        file.SetPosition(item.offset);
+        std::vector<uint8_t> chunk = file.ReadBytes(std::min<size_t>(MAP_HEADER_BYTES + compressedSize, available));
+
+        ParseMapHeader(chunk, map);
+
+        // One byte per map cell; if decompression ends early the rest stays zero (as in VB)
+        map.cells.assign(static_cast<size_t>(map.gridWidth) * map.gridHeight, 0);
+        DecodeByteRun(chunk.data() + MAP_HEADER_BYTES, chunk.size() - MAP_HEADER_BYTES, map.cells.data(), map.cells.size());
+        return true;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error decompressing map data: " << e.what() << std::endl;
+        map = MapCells();
+        return false;
+    }
+}
+
+IndexedImage ResourceDecoders::ComposeMap(const MapCells& map, const IndexedImage& atlas) {
+    IndexedImage image;
+    image.width = map.gridWidth * TILE_SIZE;
+    image.height = map.gridHeight * TILE_SIZE;
+    image.pixels.assign(static_cast<size_t>(image.width) * image.height, 0);
+    if (atlas.width < ATLAS_SIZE || atlas.height < ATLAS_SIZE) return image;
+
+    // Row by row: each 16-pixel tile line is one contiguous copy from the atlas
+    for (uint32_t cellY = 0; cellY < map.gridHeight; ++cellY) {
+        for (uint32_t cellX = 0; cellX < map.gridWidth; ++cellX) {
+            uint8_t tile = map.cells[static_cast<size_t>(cellY) * map.gridWidth + cellX];
+            const uint8_t* src = &atlas.pixels[(tile / ATLAS_COLUMNS) * TILE_SIZE * atlas.width + (tile % ATLAS_COLUMNS) * TILE_SIZE];
+            uint8_t* dst = &image.pixels[static_cast<size_t>(cellY) * TILE_SIZE * image.width + cellX * TILE_SIZE];
+            for (uint32_t y = 0; y < TILE_SIZE; ++y) {
+                std::copy_n(src + y * atlas.width, TILE_SIZE, dst + y * image.width);
+            }
+        }
+    }
+    return image;
+}
+
+size_t ResourceDecoders::PlanarImageBytes(uint32_t width, uint32_t height, uint32_t planes) {
+    size_t rowBytes = ((width + 15) / 16) * 2;
+    return rowBytes * height * planes;
+}
+
+bool ResourceDecoders::DecodePlanar(const uint8_t* data, size_t size, uint32_t width, uint32_t height,
+                                    uint32_t planes, IndexedImage& image) {
+    const size_t rowBytes = ((width + 15) / 16) * 2;
+    if (planes == 0 || planes > 8 || PlanarImageBytes(width, height, planes) > size) {
+        return false;
+    }
+
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height);
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* row = data + static_cast<size_t>(y) * planes * rowBytes;
+        uint8_t* dst = image.pixels.data() + static_cast<size_t>(y) * width;
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint32_t byteIndex = x >> 3;
+            const int bit = 7 - (x & 7);
+            uint8_t index = 0;
+            for (uint32_t p = 0; p < planes; ++p) {
+                index |= ((row[p * rowBytes + byteIndex] >> bit) & 1) << p;
+            }
+            dst[x] = index;
+        }
+    }
+    return true;
+}
+
+bool ResourceDecoders::ReadImage(const ResourceItem& item, uint32_t planes, IndexedImage& image) {
+    try {
+        if (item.sourceFile.empty()) return false;
+        BinaryFile file(item.sourceFile);
+        if (!file.IsOpen() || item.offset >= file.GetLength()) return false;
+
+        size_t available = file.GetLength() - item.offset;
+        file.SetPosition(item.offset);
+        std::vector<uint8_t> chunk = file.ReadBytes(std::min<size_t>(static_cast<size_t>(item.size) + 4, available));
+        if (chunk.size() < IMAGE_HEADER_BYTES) return false;
+
+        // Same approach as the FRML header: keep the byte order whose geometry fits the chunk
+        for (Endianness endian : {Endianness::Little, Endianness::Big}) {
+            uint32_t w = static_cast<uint16_t>(BinaryFile::ReadShort(chunk[4], chunk[5], endian));
+            uint32_t h = static_cast<uint16_t>(BinaryFile::ReadShort(chunk[6], chunk[7], endian));
+            if (w == 0 || h == 0 || w > MAX_IMAGE_DIMENSION || h > MAX_IMAGE_DIMENSION) continue;
+            if (DecodePlanar(chunk.data() + IMAGE_HEADER_BYTES, chunk.size() - IMAGE_HEADER_BYTES, w, h, planes, image)) {
+                return true;
+            }
+        }
+        return false;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading image data: " << e.what() << std::endl;
+        return false;
+    }
+}
@@ -0,0 +1,169 @@
+#include "ResourceExporter.h"
+#include "PngWriter.h"
+#include "ResourceDecoders.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+// A tileset decoded on first use by whichever task needs it first
+struct SharedAtlas {
+    std::once_flag once;
+    IndexedImage atlas;
+};
+
+std::string ItemKey(const ResourceItem& item) {
+    return item.sourceFile + "@" + std::to_string(item.offset);
+}
+
+}  // namespace
+
+ExportResult ResourceExporter::ExportImages(const ResourceIndex& index, const ExportOptions& options, ExportProgress& progress) {
+    ExportResult result;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::shared_ptr<ResourceItem>> items;
+    for (const auto& item : index.items) {
+        bool wanted = options.types.empty()
+            ? IsImageType(item->type)
+            : IsImageType(item->type) && std::find(options.types.begin(), options.types.end(), item->type) != options.types.end();
+        if (wanted && !item->sourceFile.empty()) items.push_back(item);
+    }
+    progress.total = items.size();
+
+    // Everything shared between tasks is set up here, so workers only read it
+    const std::filesystem::path outDir = options.outputDirectory;
+    std::map<std::string, std::filesystem::path> directories;
+    std::map<std::string, std::shared_ptr<ResourceItem>> tilesetFor;  // MMAP key -> CHAR item
+    std::map<std::string, std::unique_ptr<SharedAtlas>> atlases;       // CHAR key -> atlas
+    for (const auto& item : items) {
+        if (!directories.count(item->sourceFile)) {
+            std::filesystem::path dir = outDir / std::filesystem::path(item->sourceFile).stem();
+            std::error_code ec;
+            std::filesystem::create_directories(dir, ec);
+            if (ec) {
+                result.errors.push_back("Cannot create " + dir.string() + ": " + ec.message());
+                result.failed = items.size();
+                progress.failed = items.size();
+                progress.done = items.size();
+                return result;
+            }
+            directories[item->sourceFile] = dir;
+        }
+        if (item->type == ResourceType::MMAP) {
+            auto tileset = index.FindTilesetFor(*item);
+            tilesetFor[ItemKey(*item)] = tileset;
+            if (tileset) atlases.emplace(ItemKey(*tileset), nullptr);
+        } else if (item->type == ResourceType::CHAR) {
+            atlases.emplace(ItemKey(*item), nullptr);
+        }
+    }
+    for (auto& entry : atlases) {
+        entry.second = std::make_unique<SharedAtlas>();
+    }
+
+    auto getAtlas = [&](const ResourceItem& source) -> const IndexedImage& {
+        SharedAtlas& shared = *atlases.at(ItemKey(source));
+        std::call_once(shared.once, [&] {
+            std::vector<uint8_t> tileData = ResourceDecoders::ReadTileData(source.sourceFile, source.offset);
+            if (!tileData.empty()) shared.atlas = ResourceDecoders::BuildTileAtlas(tileData);
+        });
+        return shared.atlas;
+    };
+
+    std::mutex errorMutex;
+    auto reportError = [&](const ResourceItem& item, const std::string& message) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (result.errors.size() < MAX_REPORTED_ERRORS) {
+            result.errors.push_back(item.name + ": " + message);
+        }
+    };
+
+    const auto& palette = ResourceDecoders::GetPalette();
+    std::atomic<size_t> exported{0};
+    auto exportItem = [&](const ResourceItem& item) {
+        IndexedImage image;
+        bool decoded = false;
+        std::string error;
+
+        switch (item.type) {
+            case ResourceType::CHAR: {
+                image = getAtlas(item);
+                decoded = !image.pixels.empty();
+                if (!decoded) error = "no tile data";
+                break;
+            }
+            case ResourceType::MMAP: {
+                const auto& tileset = tilesetFor.at(ItemKey(item));
+                if (!tileset) {
+                    error = "no tileset in " + std::filesystem::path(item.sourceFile).filename().string();
+                    break;
+                }
+                const IndexedImage& atlas = getAtlas(*tileset);
+                MapCells map;
+                if (atlas.pixels.empty() || !ResourceDecoders::ReadMap(item, map)) {
+                    error = "map or tileset could not be decoded";
+                    break;
+                }
+                image = ResourceDecoders::ComposeMap(map, atlas);
+                decoded = true;
+                break;
+            }
+            case ResourceType::IMAG:
+                decoded = ResourceDecoders::ReadImage(item, options.imagePlanes, image);
+                if (!decoded) error = "no recognised image header";
+                break;
+            default:
+                break;
+        }
+
+        if (!decoded) {
+            progress.skipped++;
+            reportError(item, "skipped, " + error);
+            return;
+        }
+
+        std::filesystem::path file = directories.at(item.sourceFile)
+                                   / (std::string(GetResourceTypeID(item.type)) + "_" + std::to_string(item.number) + ".png");
+        if (PngWriter::WriteIndexed(file.string(), image, palette.data(), palette.size(), options.compressionLevel, error)) {
+            std::error_code ec;
+            auto size = std::filesystem::file_size(file, ec);
+            if (!ec) progress.bytesWritten += size;
+            exported++;
+        } else {
+            progress.failed++;
+            reportError(item, error);
+        }
+    };
+
+    {
+        WorkStealingPool pool(options.threads);
+        for (const auto& item : items) {
+            pool.Submit([&, item] {
+                if (!progress.cancel) {
+                    try {
+                        exportItem(*item);
+                    } catch (const std::exception& e) {
+                        progress.failed++;
+                        reportError(*item, e.what());
+                    }
+                }
+                progress.done++;
+            });
+        }
+        pool.Wait();
+    }
+
+    result.cancelled = progress.cancel;
+    result.failed = progress.failed;
+    result.skipped = progress.skipped;
+    result.bytesWritten = progress.bytesWritten;
+    result.exported = exported;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,185 @@
+#include "ResourceFileWatcher.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <set>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::filesystem::path AbsolutePath(const std::string& file) {
+    std::error_code ec;
+    std::filesystem::path path = std::filesystem::absolute(file, ec);
+    return (ec ? std::filesystem::path(file) : path).lexically_normal();
+}
+
+} // namespace
+
+ResourceFileWatcher::~ResourceFileWatcher() {
+    Stop();
+}
+
+bool ResourceFileWatcher::Start(const std::vector<std::string>& watchFiles, std::function<void()> callback, std::string& error) {
+    Stop();
+    files = watchFiles;
+    onChange = callback;
+    pending.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.clear();
+    }
+
+#ifdef __linux__
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        error = std::string("inotify_init1: ") + std::strerror(errno);
+        return false;
+    }
+    if (pipe(wakeFds) != 0) {
+        error = std::string("pipe: ") + std::strerror(errno);
+        Stop();
+        return false;
+    }
+
+    // Watching the directories rather than the files survives writers that replace by rename
+    std::set<std::filesystem::path> watchedDirectories;
+    for (const auto& file : files) {
+        std::filesystem::path path = AbsolutePath(file);
+        byPath[path] = file;
+        std::filesystem::path directory = path.parent_path();
+        if (!watchedDirectories.insert(directory).second) continue;
+
+        int wd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd < 0) {
+            error = directory.string() + ": " + std::strerror(errno);
+            Stop();
+            return false;
+        }
+        directories[wd] = directory;
+    }
+#else
+    for (const auto& file : files) {
+        Stamp& stamp = stamps[file];
+        std::error_code ec;
+        stamp.size = std::filesystem::file_size(file, ec);
+        stamp.modified = std::filesystem::last_write_time(file, ec);
+    }
+#endif
+
+    stopping = false;
+    worker = std::thread([this]() { Run(); });
+    return true;
+}
+
+void ResourceFileWatcher::Stop() {
+    if (worker.joinable()) {
+        stopping = true;
+#ifdef __linux__
+        char byte = 0;
+        [[maybe_unused]] ssize_t written = write(wakeFds[1], &byte, 1);
+#else
+        {
+            std::lock_guard<std::mutex> lock(stopMutex);
+        }
+        stopSignal.notify_all();
+#endif
+        worker.join();
+    }
+
+#ifdef __linux__
+    if (inotifyFd >= 0) close(inotifyFd);
+    for (int& fd : wakeFds) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+    inotifyFd = -1;
+    directories.clear();
+    byPath.clear();
+#else
+    stamps.clear();
+#endif
+    files.clear();
+}
+
+std::vector<std::string> ResourceFileWatcher::TakeChanged() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> changed;
+    changed.swap(ready);
+    return changed;
+}
+
+ResourceFileWatcher::Clock::duration ResourceFileWatcher::Settle() {
+    auto now = Clock::now();
+    auto next = Clock::duration::max();
+    bool settled = false;
+    for (auto it = pending.begin(); it != pending.end();) {
+        auto quiet = now - it->second;
+        if (quiet < SETTLE_TIME) {
+            next = std::min<Clock::duration>(next, SETTLE_TIME - quiet);
+            ++it;
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (std::find(ready.begin(), ready.end(), it->first) == ready.end()) ready.push_back(it->first);
+        }
+        settled = true;
+        it = pending.erase(it);
+    }
+    if (settled && onChange) onChange();
+    return next;
+}
+
+#ifdef __linux__
+void ResourceFileWatcher::Run() {
+    alignas(inotify_event) char buffer[4096];
+    while (!stopping) {
+        auto wait = Settle();
+        int timeout = wait == Clock::duration::max()
+                    ? -1 : static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(wait).count());
+
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFds[0], POLLIN, 0}};
+        if (poll(fds, 2, timeout) < 0 && errno != EINTR) break;
+        if (stopping || (fds[1].revents & POLLIN)) break;
+        if (!(fds[0].revents & POLLIN)) continue;
+
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* at = buffer; at < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(at);
+                at += sizeof(inotify_event) + event->len;
+
+                auto directory = directories.find(event->wd);
+                if (directory == directories.end() || event->len == 0) continue;
+                auto file = byPath.find(directory->second / event->name);
+                if (file != byPath.end()) pending[file->second] = Clock::now();
+            }
+        }
+    }
+}
+#else
+void ResourceFileWatcher::Run() {
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while (!stopping) {
+        for (auto& [file, stamp] : stamps) {
+            std::error_code sizeError, timeError;
+            uintmax_t size = std::filesystem::file_size(file, sizeError);
+            auto modified = std::filesystem::last_write_time(file, timeError);
+            if (sizeError || timeError) continue;   // Mid-replace; look again next time
+            if (size != stamp.size || modified != stamp.modified) {
+                stamp.size = size;
+                stamp.modified = modified;
+                pending[file] = Clock::now();
+            }
+        }
+        // A file settles once a poll finds it unchanged
+        auto wait = std::min<Clock::duration>(Settle(), POLL_INTERVAL);
+        stopSignal.wait_for(lock, wait, [this]() { return stopping.load(); });
+    }
+}
+#endif
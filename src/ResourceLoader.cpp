@@ -12,34 +12,44 @@ void ResourceLoader::SetDebugCallback(std::function<void(const std::string&)> ca
 std::unique_ptr<ResourceIndex> ResourceLoader::LoadResourceFile(const std::string& filename, Endianness endian) {
     try {
         BinaryFile file(filename);
-        if (!file.IsOpen()) {
-            if (debugCallback) debugCallback("Failed to open resource file: " + filename);
+        ResourceHeaderProbe probe;
+        ResourceHeaderError headerError = ProbeResourceHeader(file, endian, probe);
+        if (headerError != ResourceHeaderError::None) {
+            std::cerr << "Rejected resource file " << filename << ": " << DescribeHeaderError(headerError) << std::endl;
             return nullptr;
         }
-        
+        if (probe.endian != endian && debugCallback) {
+            debugCallback("Header only fits the file as " + std::string(probe.endian == Endianness::Little ? "little" : "big") + "-endian");
+        }
+        return ParseResourceFile(file, filename, probe);
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading resource file: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+std::unique_ptr<ResourceIndex> ResourceLoader::LoadResourceFile(const std::string& filename, const ResourceHeaderProbe& probe) {
+    try {
+        BinaryFile file(filename);
+        return ParseResourceFile(file, filename, probe);
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading resource file: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+std::unique_ptr<ResourceIndex> ResourceLoader::ParseResourceFile(BinaryFile& file, const std::string& filename,
+                                                                 const ResourceHeaderProbe& probe) {
+    try {
         if (debugCallback) debugCallback("File opened successfully, size: " + std::to_string(file.GetLength()) + " bytes");
         
-        // Read header (try both endianness for debug)
-        ResourceHeader headerLE = ReadResourceHeader(file, Endianness::Little);
-        if (debugCallback) debugCallback("[DEBUG] Header (Little Endian): size=" + std::to_string(headerLE.size) + ", dataSegmentSize=" + std::to_string(headerLE.dataSegmentSize) + ", dataSize=" + std::to_string(headerLE.dataSize) + ", fileEndLength=" + std::to_string(headerLE.fileEndLength));
-        ResourceHeader headerBE = ReadResourceHeader(file, Endianness::Big);
-        if (debugCallback) debugCallback("[DEBUG] Header (Big Endian): size=" + std::to_string(headerBE.size) + ", dataSegmentSize=" + std::to_string(headerBE.dataSegmentSize) + ", dataSize=" + std::to_string(headerBE.dataSize) + ", fileEndLength=" + std::to_string(headerBE.fileEndLength));
-        // Use the original logic for now
-        ResourceHeader header = ReadResourceHeader(file, endian);
+        const Endianness endian = probe.endian;
+        const ResourceHeader& header = probe.header;
         if (debugCallback) debugCallback("Resource file size: " + std::to_string(header.size) + " bytes");
+        if (debugCallback) debugCallback("ChunkTypeQty=" + std::to_string(probe.typeCount));
+        auto identifiers = ReadResourceIdentifiers(file, probe.trailer + TYPE_COUNT_OFFSET + 2, probe.typeCount, endian);
         
-        // Calculate file pointer position
-        uint32_t filePointer = (header.dataSegmentSize + header.size) + 14;
-        
-        // chunk type quantity
-        uint32_t chunkTypePtr = (header.dataSegmentSize + header.size) + 12;
-        file.SetPosition(chunkTypePtr);
-        uint16_t chunkTypeQty = file.ReadWordUnsigned(endian) + 1;
-        if (debugCallback) debugCallback("ChunkTypeQty=" + std::to_string(chunkTypeQty));
-        auto identifiers = ReadResourceIdentifiers(file, filePointer, chunkTypeQty, endian);
-        
-        // Get key position
-        uint32_t keyPosition = GetResourceKeyPosition(file, endian);
+        uint32_t keyPosition = probe.keyPosition;
         
         // Create resource index
         auto resourceIndex = std::make_unique<ResourceIndex>("WIME");
@@ -71,7 +81,7 @@ std::unique_ptr<ResourceIndex> ResourceLoader::LoadResourceFile(const std::strin
 
                 std::string resourceName = identifier.resourceID + " " + std::to_string(map.number);
                 ResourceType resourceType = GetResourceType(identifier.resourceID);
-                resourceIndex->AddItem(resourceName, actualOffset, chunkSize, resourceType, filename);
+                resourceIndex->AddItem(resourceName, actualOffset, chunkSize, resourceType, filename, map.number);
 
                 tk++;
             }
@@ -86,18 +96,87 @@ std::unique_ptr<ResourceIndex> ResourceLoader::LoadResourceFile(const std::strin
     }
 }
 
-ResourceHeader ResourceLoader::ReadResourceHeader(BinaryFile& file, Endianness endian) {
-    file.SetPosition(0);
-    
+ResourceHeader ResourceLoader::DecodeResourceHeader(const uint8_t* bytes, Endianness endian) {
+    auto longword = [&](int offset) {
+        const uint8_t* p = bytes + offset;
+        return endian == Endianness::Big
+            ? (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3]
+            : (uint32_t(p[3]) << 24) | (uint32_t(p[2]) << 16) | (uint32_t(p[1]) << 8) | p[0];
+    };
     ResourceHeader header;
-    header.size = file.ReadLongwordUnsigned(endian);
-    header.dataSegmentSize = file.ReadLongwordUnsigned(endian);
-    header.dataSize = file.ReadLongwordUnsigned(endian);
-    header.fileEndLength = file.ReadLongwordUnsigned(endian);
-    
+    header.size = longword(0);
+    header.dataSegmentSize = longword(4);
+    header.dataSize = longword(8);
+    header.fileEndLength = longword(12);
     return header;
 }
 
+ResourceHeaderError ResourceLoader::CheckResourceHeader(const ResourceHeader& header, uint64_t fileLength) {
+    if (fileLength < HEADER_BYTES + TYPE_COUNT_OFFSET + 2) return ResourceHeaderError::TooSmall;
+    if (header.size < HEADER_BYTES || header.size > fileLength) return ResourceHeaderError::BadHeaderSize;
+    const uint64_t trailer = uint64_t(header.size) + header.dataSegmentSize;
+    if (trailer + TYPE_COUNT_OFFSET + 2 > fileLength) return ResourceHeaderError::TrailerOutOfRange;
+    return ResourceHeaderError::None;
+}
+
+ResourceHeaderError ResourceLoader::ProbeResourceHeader(BinaryFile& file, Endianness preferred, ResourceHeaderProbe& probe) {
+    const uint64_t length = file.GetLength();
+    if (length < HEADER_BYTES + TYPE_COUNT_OFFSET + 2) return ResourceHeaderError::TooSmall;
+
+    file.SetPosition(0);
+    const std::vector<uint8_t> bytes = file.ReadBytes(HEADER_BYTES);
+    const Endianness other = preferred == Endianness::Big ? Endianness::Little : Endianness::Big;
+    const ResourceHeader wanted = DecodeResourceHeader(bytes.data(), preferred);
+    const ResourceHeader swapped = DecodeResourceHeader(bytes.data(), other);
+    const ResourceHeaderError wantedError = CheckResourceHeader(wanted, length);
+    const ResourceHeaderError swappedError = CheckResourceHeader(swapped, length);
+
+    // Sizes that fit in one order are nonsense in the other, so this rarely needs the tie-break
+    if (wantedError != ResourceHeaderError::None && swappedError != ResourceHeaderError::None) return wantedError;
+    bool useSwapped = wantedError != ResourceHeaderError::None;
+    if (wantedError == ResourceHeaderError::None && swappedError == ResourceHeaderError::None) {
+        // Size fields that agree count once each; a known first type ID outweighs both
+        auto plausibility = [&](const ResourceHeader& header, Endianness order) {
+            const uint64_t trailer = uint64_t(header.size) + header.dataSegmentSize;
+            int points = int(header.dataSize == header.dataSegmentSize) + int(header.fileEndLength == length - trailer);
+            const uint64_t firstIdentifier = trailer + TYPE_COUNT_OFFSET + 2;
+            if (firstIdentifier + 4 <= length) {
+                file.SetPosition(firstIdentifier);
+                const std::vector<uint8_t> idBytes = file.ReadBytes(4);
+                // Type IDs are stored byte-reversed on little-endian platforms
+                std::string id;
+                for (int i = 0; i < 4; ++i) id += static_cast<char>(idBytes[order == Endianness::Big ? i : 3 - i]);
+                ResourceType type;
+                if (ParseResourceTypeID(id, type)) points += KNOWN_TYPE_POINTS;
+            }
+            return points;
+        };
+        useSwapped = plausibility(swapped, other) > plausibility(wanted, preferred);
+    }
+    probe.header = useSwapped ? swapped : wanted;
+    probe.endian = useSwapped ? other : preferred;
+    probe.trailer = probe.header.size + probe.header.dataSegmentSize;
+
+    file.SetPosition(probe.trailer + TYPE_COUNT_OFFSET);
+    probe.typeCount = file.ReadWordUnsigned(probe.endian) + 1;
+    const uint64_t keyPosition = uint64_t(probe.trailer) + TYPE_COUNT_OFFSET + 2 + 8ull * probe.typeCount;
+    if (keyPosition > length) return ResourceHeaderError::TypeTableOutOfRange;
+    probe.keyPosition = static_cast<uint32_t>(keyPosition);
+    return ResourceHeaderError::None;
+}
+
+const char* ResourceLoader::DescribeHeaderError(ResourceHeaderError error) {
+    switch (error) {
+        case ResourceHeaderError::None: return "no error";
+        case ResourceHeaderError::CannotOpen: return "file cannot be opened";
+        case ResourceHeaderError::TooSmall: return "file is too small for a resource header";
+        case ResourceHeaderError::BadHeaderSize: return "header size does not fit the file in either byte order";
+        case ResourceHeaderError::TrailerOutOfRange: return "data segment runs past the end of the file";
+        case ResourceHeaderError::TypeTableOutOfRange: return "type table runs past the end of the file";
+    }
+    return "unknown error";
+}
+
 std::vector<ResourceIdentifier> ResourceLoader::ReadResourceIdentifiers(BinaryFile& file, uint32_t filePointer, uint16_t expectedCount, Endianness endian) {
     std::vector<ResourceIdentifier> identifiers;
     
@@ -148,23 +227,6 @@ std::vector<ResourceMap> ResourceLoader::ReadResourceMaps(BinaryFile& file, uint
     return maps;
 }
 
-uint32_t ResourceLoader::GetResourceKeyPosition(BinaryFile& file, Endianness endian) {
-    // Replicate VB.NET logic to find resource map key start position
-    file.SetPosition(0);
-    uint32_t headerSize = file.ReadLongwordUnsigned(endian);           // header.size
-    uint32_t dataSegmentSize = file.ReadLongwordUnsigned(endian);     // header.dataSegmentSize
-
-    // Position after header fields
-    uint32_t chunkTypePtr = (dataSegmentSize + headerSize) + 12;      // points to chunk type quantity word
-
-    file.SetPosition(chunkTypePtr);
-    uint16_t chunkQty = file.ReadWordUnsigned(endian);
-    chunkQty += 1; // VB adds 1
-
-    uint32_t keyPosition = (dataSegmentSize + headerSize) + 14 + (8 * chunkQty);
-    return keyPosition;
-}
-
 std::string ResourceLoader::GetChunkID(BinaryFile& file, uint32_t offset, Endianness endian) {
     if (debugCallback) debugCallback("GetChunkID: reading at offset " + std::to_string(offset));
     
@@ -258,20 +320,3 @@ ResourceType ResourceLoader::GetResourceType(const std::string& resourceID) {
     if (resourceID == "MMAP") return ResourceType::MMAP;
     return ResourceType::CHAR; // Default
 }
-
-bool ResourceLoader::ValidateResourceHeader(const std::string& filename, Endianness endian) {
-    try {
-        BinaryFile file(filename);
-        if (!file.IsOpen()) return false;
-        
-        // Read header and validate
-        ResourceHeader header = ReadResourceHeader(file, endian);
-        
-        // Basic validation - file should be at least header size
-        if (header.size < 16) return false;
-        
-        return true;
-    } catch (...) {
-        return false;
-    }
-} 
\ No newline at end of file
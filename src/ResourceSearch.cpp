@@ -0,0 +1,189 @@
+#include "ResourceSearch.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WIME_HAVE_SSE2 1
+#endif
+
+namespace {
+    inline uint8_t FoldCase(uint8_t c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c | 0x20) : c;
+    }
+
+    bool MatchesAt(const uint8_t* data, const std::vector<uint8_t>& pattern, bool ignoreCase) {
+        if (!ignoreCase) {
+            return std::memcmp(data, pattern.data(), pattern.size()) == 0;
+        }
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            if (FoldCase(data[i]) != pattern[i]) return false;
+        }
+        return true;
+    }
+
+    // Next position in [from, end) whose byte equals `first` (case-folded when ignoreCase)
+    const uint8_t* NextCandidate(const uint8_t* from, const uint8_t* end, uint8_t first, bool ignoreCase) {
+        const bool folds = ignoreCase && first >= 'a' && first <= 'z';
+        if (!folds) {
+            return static_cast<const uint8_t*>(std::memchr(from, first, end - from));
+        }
+#ifdef WIME_HAVE_SSE2
+        // Setting bit 5 folds A-Z onto a-z; other bytes that land on `first` are rejected by MatchesAt
+        const __m128i needle = _mm_set1_epi8(static_cast<char>(first));
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        while (end - from >= 16) {
+            __m128i block = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(from)), caseBit);
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+            if (mask != 0) {
+                int bit = 0;
+                while (((mask >> bit) & 1) == 0) ++bit;
+                return from + bit;
+            }
+            from += 16;
+        }
+#endif
+        for (; from < end; ++from) {
+            if (FoldCase(*from) == first) return from;
+        }
+        return nullptr;
+    }
+
+    struct FileTask {
+        const MappedFile* file;
+        size_t begin;
+        size_t end;  // Exclusive; matches must start before end but may run past it
+    };
+}
+
+bool ResourceSearch::ParseHexPattern(const std::string& text, std::vector<uint8_t>& pattern) {
+    pattern.clear();
+    int nibbles = 0;
+    uint8_t current = 0;
+    for (char c : text) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (std::isspace(uc)) continue;
+        if (!std::isxdigit(uc)) return false;
+        int value = std::isdigit(uc) ? uc - '0' : std::toupper(uc) - 'A' + 10;
+        current = static_cast<uint8_t>((current << 4) | value);
+        if (++nibbles % 2 == 0) {
+            pattern.push_back(current);
+            current = 0;
+        }
+    }
+    return !pattern.empty() && nibbles % 2 == 0;
+}
+
+void ResourceSearch::FindAll(const uint8_t* data, size_t size, const std::vector<uint8_t>& pattern,
+                             bool ignoreCase, std::vector<size_t>& hits, size_t maxHits) {
+    if (pattern.empty() || size < pattern.size()) return;
+
+    std::vector<uint8_t> folded;
+    const std::vector<uint8_t>* needle = &pattern;
+    if (ignoreCase) {
+        folded.resize(pattern.size());
+        std::transform(pattern.begin(), pattern.end(), folded.begin(), FoldCase);
+        needle = &folded;
+    }
+
+    const uint8_t* end = data + size - pattern.size() + 1;  // Last possible start + 1
+    const uint8_t* pos = data;
+    size_t found = 0;
+    while (pos < end && found < maxHits) {
+        pos = NextCandidate(pos, end, (*needle)[0], ignoreCase);
+        if (!pos) break;
+        if (MatchesAt(pos, *needle, ignoreCase)) {
+            hits.push_back(static_cast<size_t>(pos - data));
+            found++;
+        }
+        ++pos;
+    }
+}
+
+std::vector<SearchHit> ResourceSearch::Search(const std::vector<std::shared_ptr<ResourceItem>>& items,
+                                              const SearchQuery& query, SearchProgress* progress) {
+    std::vector<SearchHit> results;
+    if (query.pattern.empty()) return results;
+
+    // Resources per file, sorted by offset so hits can be attributed by binary search
+    std::map<std::string, std::vector<std::shared_ptr<ResourceItem>>> itemsByFile;
+    for (const auto& item : items) {
+        if (!item->sourceFile.empty()) itemsByFile[item->sourceFile].push_back(item);
+    }
+    for (auto& [file, fileItems] : itemsByFile) {
+        std::sort(fileItems.begin(), fileItems.end(), [](const auto& a, const auto& b) { return a->offset < b->offset; });
+    }
+
+    std::vector<std::unique_ptr<MappedFile>> files;
+    std::vector<FileTask> tasks;
+    for (const auto& entry : itemsByFile) {
+        try {
+            files.push_back(std::make_unique<MappedFile>(entry.first));
+        } catch (const std::exception& e) {
+            std::cerr << "Search: " << e.what() << std::endl;
+            continue;
+        }
+        const MappedFile* file = files.back().get();
+        for (size_t begin = 0; begin < file->Size(); begin += CHUNK_BYTES) {
+            tasks.push_back({file, begin, std::min(file->Size(), begin + CHUNK_BYTES)});
+        }
+        if (progress) progress->bytesTotal += file->Size();
+    }
+
+    // Workers pull chunks off a shared counter; each chunk overlaps the next by pattern length - 1
+    std::mutex resultMutex;
+    std::map<const MappedFile*, std::vector<size_t>> fileHits;
+    std::atomic<size_t> nextTask{0};
+    std::atomic<size_t> totalHits{0};
+
+    auto worker = [&]() {
+        std::vector<size_t> local;
+        for (size_t t = nextTask++; t < tasks.size(); t = nextTask++) {
+            if ((progress && progress->cancel) || totalHits >= query.maxHits) break;
+            const FileTask& task = tasks[t];
+            size_t scanEnd = std::min(task.file->Size(), task.end + query.pattern.size() - 1);
+            local.clear();
+            FindAll(task.file->Data() + task.begin, scanEnd - task.begin, query.pattern, query.ignoreCase, local, query.maxHits);
+            if (!local.empty()) {
+                totalHits += local.size();
+                std::lock_guard<std::mutex> lock(resultMutex);
+                auto& hits = fileHits[task.file];
+                for (size_t hit : local) hits.push_back(task.begin + hit);
+            }
+            if (progress) progress->bytesScanned += task.end - task.begin;
+        }
+    };
+
+    size_t threadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, std::max<size_t>(tasks.size(), 1));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i) threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads) thread.join();
+
+    // Attribute file offsets to the resource chunk containing them
+    for (const auto& file : files) {
+        auto found = fileHits.find(file.get());
+        if (found == fileHits.end()) continue;
+        std::vector<size_t>& hits = found->second;
+        std::sort(hits.begin(), hits.end());
+
+        const auto& fileItems = itemsByFile[file->GetFilename()];
+        for (size_t hit : hits) {
+            auto it = std::upper_bound(fileItems.begin(), fileItems.end(), hit,
+                                       [](size_t offset, const auto& item) { return offset < item->offset; });
+            if (it == fileItems.begin()) continue;
+            const auto& item = *std::prev(it);
+            if (hit + query.pattern.size() <= static_cast<size_t>(item->offset) + item->size) {
+                results.push_back({item, static_cast<uint32_t>(hit - item->offset)});
+                if (results.size() >= query.maxHits) return results;
+            }
+        }
+    }
+    return results;
+}
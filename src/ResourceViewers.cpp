@@ -1,9 +1,10 @@
 #include "ResourceViewers.h"
 #include "BinaryFile.h"
+#include "Profiler.h"
 #include <imgui.h>
 #include <iostream>
 #include <algorithm>
-#include <map>
+#include <array>
 
 // Forward declaration
 const char* GetResourceTypeString(ResourceType type);
@@ -17,15 +18,23 @@ std::unique_ptr<ResourceViewer> CreateResourceViewer(ResourceType type) {
             return std::make_unique<MapResourceViewer>();
         case ResourceType::CHAR:
             return std::make_unique<CharResourceViewer>();
+        case ResourceType::FRML:
+            return std::make_unique<FormResourceViewer>();
         default:
             return std::make_unique<BinaryResourceViewer>();
     }
 }
 
 // StringResourceViewer implementation
+StringResourceViewer::EditCallback StringResourceViewer::editCallback;
+
+void StringResourceViewer::SetEditCallback(EditCallback callback) {
+    editCallback = callback;
+}
+
 void StringResourceViewer::SetResource(const std::shared_ptr<ResourceItem>& resource) {
     this->resource = resource;
-    dataLoaded = false;
+    ClearCache();
 }
 
 void StringResourceViewer::SetGameFilePath(const std::string& filePath) {
@@ -35,48 +44,83 @@ void StringResourceViewer::SetGameFilePath(const std::string& filePath) {
 
 void StringResourceViewer::ClearCache() {
     cachedData.clear();
+    loadError.clear();
     dataLoaded = false;
+    editBuffer.clear();
+    editSuffix.clear();
+    editInitialised = false;
+    dirty = false;
+}
+
+void StringResourceViewer::RevertEdits() {
+    SplitEditText(LoadStringData());
+    OnTextEdited();
+}
+
+void StringResourceViewer::SplitEditText(const std::string& data) {
+    size_t terminator = data.find('\0');
+    editBuffer = data.substr(0, terminator);
+    editSuffix = terminator == std::string::npos ? std::string() : data.substr(terminator);
 }
 
-std::string StringResourceViewer::LoadStringData() {
+void StringResourceViewer::OnTextEdited() {
+    if (!resource) return;
+    std::string payload = GetEditedPayload();
+    dirty = payload != cachedData;
+    if (resourceEdits) {
+        if (dirty) {
+            resourceEdits->Set(resource, std::vector<uint8_t>(payload.begin(), payload.end()));
+        } else {
+            resourceEdits->Discard(*resource);
+        }
+    }
+    if (editCallback) {
+        editCallback(resource, payload);
+    }
+}
+
+const std::string& StringResourceViewer::LoadStringData() {
     if (dataLoaded) return cachedData;
+    dataLoaded = true;
     
     try {
         if (resource->sourceFile.empty()) {
-            return "Error: No source file specified";
+            loadError = "No source file specified";
+            return cachedData;
         }
         
         BinaryFile file(resource->sourceFile);
         if (!file.IsOpen()) {
-            return "Error: Could not open source file";
+            loadError = "Could not open source file";
+            return cachedData;
         }
         
-        // Match VB: seek to offset+4, read exactly size bytes, convert 10 to \n
+        // Match VB: seek to offset+4, read exactly size bytes
         size_t start = resource->offset + 4;
         if (start >= file.GetLength()) {
-            return "Error: Start position past end of file";
+            loadError = "Start position past end of file";
+            return cachedData;
         }
         
         file.SetPosition(start);
-        std::string data;
-        data.reserve(resource->size);
-        
-        for (uint32_t i = 0; i < resource->size && file.GetPosition() < file.GetLength(); ++i) {
-            uint8_t byte = file.ReadByteUnsigned();
-            if (byte == 10) {
-                data += '\n';
-            } else {
-                data += static_cast<char>(byte);
-            }
-        }
-        
-        cachedData = data;
-        dataLoaded = true;
-        return data;
+        std::vector<uint8_t> bytes = file.ReadBytes(std::min<size_t>(resource->size, file.GetLength() - start));
+        cachedData.assign(bytes.begin(), bytes.end());
+        return cachedData;
         
     } catch (const std::exception& e) {
-        return "Error reading string data: " + std::string(e.what());
+        loadError = "Error reading string data: " + std::string(e.what());
+        return cachedData;
+    }
+}
+
+int StringResourceViewer::ResizeEditBuffer(ImGuiInputTextCallbackData* data) {
+    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize) {
+        // ImGui asks for more room; grow the string and hand back its storage
+        std::string* buffer = static_cast<std::string*>(data->UserData);
+        buffer->resize(data->BufTextLen);
+        data->Buf = buffer->data();
     }
+    return 0;
 }
 
 void StringResourceViewer::RenderProperties() {
@@ -95,7 +139,7 @@ void StringResourceViewer::RenderProperties() {
     ImGui::Separator();
     
     ImGui::Text("String Content:");
-    std::string data = LoadStringData();
+    const std::string& data = LoadStringData();
     if (!data.empty()) {
         ImGui::TextWrapped("%s", data.c_str());
         
@@ -122,6 +166,8 @@ void StringResourceViewer::RenderProperties() {
                 ImGui::Text("... (truncated)");
             }
         }
+    } else if (!loadError.empty()) {
+        ImGui::Text("(%s)", loadError.c_str());
     } else {
         ImGui::Text("(Failed to read string data)");
     }
@@ -136,28 +182,46 @@ void StringResourceViewer::RenderPreview() {
     ImGui::Text("String Editor");
     ImGui::Separator();
     
-    // Load and display string in editable format
-    std::string data = LoadStringData();
-    if (!data.empty()) {
-        ImGui::Text("Edit the string below:");
-        ImGui::PushID(this);
-        // ImGui InputTextMultiline requires a char buffer, not std::string*
-        static char buffer[4096]; // Static buffer for editing
-        strncpy(buffer, data.c_str(), sizeof(buffer) - 1);
-        buffer[sizeof(buffer) - 1] = '\0';
-        if (ImGui::InputTextMultiline("##editstring", buffer, sizeof(buffer), ImVec2(-1, 300))) {
-            // Handle string editing here
-            // TODO: Implement save functionality
+    const std::string& data = LoadStringData();
+    if (!loadError.empty()) {
+        ImGui::Text("(%s)", loadError.c_str());
+        return;
+    }
+    
+    // Copied once per selection, from unsaved edits if there are any;
+    // after that ImGui edits editBuffer in place
+    if (!editInitialised) {
+        const ResourceEdit* pending = resourceEdits ? resourceEdits->Find(*resource) : nullptr;
+        if (pending) {
+            SplitEditText(std::string(pending->payload.begin(), pending->payload.end()));
+        } else {
+            SplitEditText(data);
         }
-        ImGui::PopID();
-        
-        ImGui::Separator();
-        ImGui::Text("String Statistics:");
-        ImGui::Text("Length: %zu characters", data.length());
-        ImGui::Text("Lines: %zu", std::count(data.begin(), data.end(), '\n') + 1);
-    } else {
-        ImGui::Text("(Failed to read string data)");
+        editInitialised = true;
+        dirty = pending != nullptr;
     }
+    
+    ImGui::Text("Edit the string below:%s", dirty ? " (modified)" : "");
+    ImGui::PushID(this);
+    if (ImGui::InputTextMultiline("##editstring", editBuffer.data(), editBuffer.capacity() + 1, ImVec2(-1, 300),
+                                  ImGuiInputTextFlags_CallbackResize, ResizeEditBuffer, &editBuffer)) {
+        OnTextEdited();
+    }
+    ImGui::PopID();
+    
+    ImGui::BeginDisabled(!dirty);
+    if (ImGui::Button("Revert")) {
+        RevertEdits();
+    }
+    ImGui::EndDisabled();
+    
+    ImGui::Separator();
+    ImGui::Text("String Statistics:");
+    ImGui::Text("Length: %zu characters (%zu original)", editBuffer.length(), std::min(data.find('\0'), data.length()));
+    if (!editSuffix.empty()) {
+        ImGui::Text("%zu bytes from the terminator on are kept unchanged", editSuffix.length());
+    }
+    ImGui::Text("Lines: %zu", std::count(editBuffer.begin(), editBuffer.end(), '\n') + 1);
 }
 
 // MapResourceViewer implementation
@@ -172,84 +236,112 @@ void MapResourceViewer::SetGameFilePath(const std::string& filePath) {
 }
 
 void MapResourceViewer::ClearCache() {
-    cachedDecompressedData.clear();
+    mapCells = MapCells();
     dataLoaded = false;
+    headerRecognised = false;
+    tileUsage.reset();
+    tileset.reset();
+    tilesetResolved = false;
+    tileAtlas.Release();
 }
 
-std::vector<uint8_t> MapResourceViewer::DecompressMapData() {
-    if (dataLoaded) return cachedDecompressedData;
+void MapResourceViewer::SetResourceIndex(const ResourceIndex* index) {
+    resourceIndex = index;
+    tilesetResolved = false;
+}
+
+std::unordered_map<std::string, std::shared_ptr<ResourceItem>> MapResourceViewer::tilesetPairing;
+std::unordered_map<std::string, std::shared_ptr<const MapResourceViewer::Tileset>> MapResourceViewer::tilesetCache;
+
+void MapResourceViewer::ClearTilesetCache() {
+    tilesetPairing.clear();
+    tilesetCache.clear();
+}
+
+void MapResourceViewer::ClearTilesetCache(const std::string& sourceFile) {
+    // Maps and their tilesets always share a file, so both keys start with it
+    const std::string prefix = sourceFile + "@";
+    std::erase_if(tilesetPairing, [&prefix](const auto& entry) { return entry.first.compare(0, prefix.size(), prefix) == 0; });
+    std::erase_if(tilesetCache, [&prefix](const auto& entry) { return entry.first.compare(0, prefix.size(), prefix) == 0; });
+}
+
+const MapResourceViewer::Tileset* MapResourceViewer::ResolveTileset() {
+    if (tilesetResolved) return tileset.get();
+    tilesetResolved = true;
     
-    try {
-        if (resource->sourceFile.empty()) {
-            return {};
-        }
-        
-        BinaryFile file(resource->sourceFile);
-        if (!file.IsOpen()) {
-            return {};
-        }
-        
-        // MMAP specific: DataStartOffset = offset + 8, chunkSize = size - 18
-        uint32_t dataStartOffset = resource->offset + 8;
-        uint32_t chunkSize = resource->size - 18;
-        
-        if (dataStartOffset >= file.GetLength()) {
-            return {};
-        }
-        
-        file.SetPosition(dataStartOffset);
-        
-        // Calculate expected decompressed size (matching VB logic)
-        auto CalculateRowSize = [](uint32_t imageWidth) -> uint32_t {
-            uint32_t rowSizeInWords = imageWidth / 16;
-            if (imageWidth % 16 != 0) rowSizeInWords++;
-            return rowSizeInWords * 2;
-        };
-        uint32_t expectedDecompressedSize = CalculateRowSize(width) * height * planes;
-        std::vector<uint8_t> decompressedData(expectedDecompressedSize, 0);
-        
-        uint32_t readBytes = 0;
-        uint32_t count = 0;
-        while (readBytes < chunkSize && count < expectedDecompressedSize) {
-            int8_t runByte = file.ReadByteSigned();
-            readBytes++;
-            if (runByte >= 0 && runByte <= 127) {
-                for (int i = 0; i <= runByte && count < expectedDecompressedSize && readBytes < chunkSize; i++) {
-                    decompressedData[count++] = file.ReadByteUnsigned();
-                    readBytes++;
-                }
-            } else if (runByte >= -127 && runByte <= -1) {
-                uint8_t repeatByte = file.ReadByteUnsigned();
-                readBytes++;
-                for (int i = 0; i <= -runByte && count < expectedDecompressedSize; i++) {
-                    decompressedData[count++] = repeatByte;
-                }
-            }
-        }
-        // If decompression ended early, the rest of the buffer remains zero (as in VB)
-        cachedDecompressedData = decompressedData;
-        dataLoaded = true;
-        return decompressedData;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error decompressing map data: " << e.what() << std::endl;
-        return {};
+    std::string mapKey = resource->sourceFile + "@" + std::to_string(resource->offset);
+    auto pairing = tilesetPairing.find(mapKey);
+    if (pairing == tilesetPairing.end()) {
+        if (!resourceIndex) return nullptr;
+        pairing = tilesetPairing.emplace(mapKey, resourceIndex->FindTilesetFor(*resource)).first;
+    }
+    const std::shared_ptr<ResourceItem>& source = pairing->second;
+    if (!source) return nullptr;
+    
+    std::string tilesetKey = source->sourceFile + "@" + std::to_string(source->offset);
+    auto cached = tilesetCache.find(tilesetKey);
+    if (cached == tilesetCache.end()) {
+        ScopedTimer timer("MapViewer: decode tileset");
+        auto decoded = std::make_shared<Tileset>();
+        decoded->source = source;
+        std::vector<uint8_t> tileData = ResourceDecoders::ReadTileData(source->sourceFile, source->offset);
+        if (tileData.empty()) return nullptr;
+        ResourceDecoders::ExpandPalette(ResourceDecoders::BuildTileAtlas(tileData), decoded->atlas);
+        cached = tilesetCache.emplace(tilesetKey, std::move(decoded)).first;
     }
+    tileset = cached->second;
+    return tileset.get();
 }
 
-
+const std::vector<uint8_t>& MapResourceViewer::DecompressMapData() {
+    if (dataLoaded) return mapCells.cells;
+    dataLoaded = true;
+    
+    ScopedTimer timer("MapViewer: read map");
+    ResourceDecoders::ReadMap(*resource, mapCells);
+    mapGridWidth = mapCells.gridWidth;
+    mapGridHeight = mapCells.gridHeight;
+    headerRecognised = mapCells.headerRecognised;
+    width = mapGridWidth * TILE_SIZE;
+    height = mapGridHeight * TILE_SIZE;
+    return mapCells.cells;
+}
 
 void MapResourceViewer::RenderMapProperties() {
+    DecompressMapData();
     ImGui::Text("Map Properties:");
     ImGui::Text("  Width: %u pixels", width);
     ImGui::Text("  Height: %u pixels", height);
-    ImGui::Text("  Planes: %u", planes);
-    ImGui::Text("  Grid: %ux%u tiles", mapGridWidth, mapGridHeight);
+    ImGui::Text("  Grid: %ux%u tiles%s", mapGridWidth, mapGridHeight, headerRecognised ? "" : " (default, header not recognised)");
     ImGui::Text("  Tile Size: 16x16 pixels");
+    
+    const Tileset* tiles = ResolveTileset();
+    if (tiles) {
+        ImGui::Text("  Tileset: %s (offset 0x%08X)", tiles->source->name.c_str(), tiles->source->offset);
+    } else {
+        ImGui::Text("  Tileset: (no CHAR resource in this file)");
+    }
+}
+
+void MapResourceViewer::RenderTileUsage() {
+    const std::vector<uint8_t>& mapData = DecompressMapData();
+    if (mapData.empty()) return;
+    
+    if (!tileUsage) {
+        tileUsage = ResourceAnalysis::GetCached(*resource, "cells", mapData);
+    }
+    
+    ImGui::Text("Tile Usage:");
+    ImGui::Text("  Distinct tiles: %zu of 256", tileUsage->uniqueValues);
+    ImGui::Text("  Entropy: %.3f bits/cell", tileUsage->entropy);
+    for (const auto& [tile, count] : ResourceAnalysis::TopValues(*tileUsage, 8)) {
+        ImGui::Text("  Tile 0x%02X: %llu cells (%.1f%%)", tile, static_cast<unsigned long long>(count),
+                    100.0 * count / tileUsage->totalBytes);
+    }
 }
 
 void MapResourceViewer::RenderMapGrid() {
-    std::vector<uint8_t> mapData = DecompressMapData();
+    const std::vector<uint8_t>& mapData = DecompressMapData();
     if (mapData.empty()) {
         ImGui::Text("(Failed to decompress map data)");
         return;
@@ -300,6 +392,9 @@ void MapResourceViewer::RenderProperties() {
     RenderMapProperties();
     ImGui::Separator();
     
+    RenderTileUsage();
+    ImGui::Separator();
+    
     RenderMapGrid();
 }
 
@@ -312,7 +407,7 @@ void MapResourceViewer::RenderPreview() {
     ImGui::Text("Map Viewer");
     ImGui::Separator();
     
-    std::vector<uint8_t> mapData = DecompressMapData();
+    const std::vector<uint8_t>& mapData = DecompressMapData();
     if (mapData.empty()) {
         ImGui::Text("(Failed to decompress map data)");
         return;
@@ -321,33 +416,13 @@ void MapResourceViewer::RenderPreview() {
     ImGui::Text("Grid: %ux%u tiles", mapGridWidth, mapGridHeight);
     ImGui::Separator();
     
-    // Load tile data from CHAR resource
-    std::vector<uint8_t> tileData = CharResourceViewer::GetTileData(resource->sourceFile, 0xAB7F);
-    
-    if (!tileData.empty()) {
-        RenderMapWithTiles(mapData, tileData);
+    // Tileset is resolved and decoded once, not per frame
+    const Tileset* tiles = ResolveTileset();
+    if (tiles) {
+        RenderMapWithTiles(mapData, *tiles);
     } else {
-        // Fallback to colored squares if no tile data
-        const int tileScale = 2;
-        ImVec2 canvasPos = ImGui::GetCursorScreenPos();
-        ImDrawList* drawList = ImGui::GetWindowDrawList();
-        
-        auto getColor = [](uint8_t value) -> ImU32 {
-            return IM_COL32(value, value, value, 255);
-        };
-        
-        for (uint32_t row = 0; row < mapGridHeight; ++row) {
-            for (uint32_t col = 0; col < mapGridWidth; ++col) {
-                size_t index = row * mapGridWidth + col;
-                if (index < mapData.size()) {
-                    ImU32 color = getColor(mapData[index]);
-                    ImVec2 p0 = ImVec2(canvasPos.x + col * tileScale, canvasPos.y + row * tileScale);
-                    ImVec2 p1 = ImVec2(p0.x + tileScale, p0.y + tileScale);
-                    drawList->AddRectFilled(p0, p1, color);
-                }
-            }
-        }
-        ImGui::Dummy(ImVec2(mapGridWidth * tileScale, mapGridHeight * tileScale));
+        // Fallback to greyscale cells if no tile data
+        RenderMapCells(mapData);
     }
     
     ImGui::Separator();
@@ -360,7 +435,7 @@ void MapResourceViewer::RenderPreview() {
 // BinaryResourceViewer implementation
 void BinaryResourceViewer::SetResource(const std::shared_ptr<ResourceItem>& resource) {
     this->resource = resource;
-    dataLoaded = false;
+    ClearCache();
 }
 
 void BinaryResourceViewer::SetGameFilePath(const std::string& filePath) {
@@ -369,72 +444,52 @@ void BinaryResourceViewer::SetGameFilePath(const std::string& filePath) {
 }
 
 void BinaryResourceViewer::ClearCache() {
+    hexView.SetData(nullptr);
     cachedData.clear();
     dataLoaded = false;
+    statistics.reset();
 }
 
-std::vector<uint8_t> BinaryResourceViewer::LoadBinaryData() {
+void BinaryResourceViewer::GoToOffset(size_t offset, size_t length) {
+    if (!resource) return;
+    const std::vector<uint8_t>& data = LoadBinaryData();
+    if (offset >= data.size()) return;
+    hexView.SetData(&data);
+    hexView.Select(offset, std::min(length, data.size() - offset));
+}
+
+const std::vector<uint8_t>& BinaryResourceViewer::LoadBinaryData() {
     if (dataLoaded) return cachedData;
+    dataLoaded = true;
     
     try {
         if (resource->sourceFile.empty()) {
-            return {};
+            return cachedData;
         }
         
         BinaryFile file(resource->sourceFile);
-        if (!file.IsOpen()) {
-            return {};
+        if (!file.IsOpen() || resource->offset >= file.GetLength()) {
+            return cachedData;
         }
         
+        size_t available = file.GetLength() - resource->offset;
         file.SetPosition(resource->offset);
-        std::vector<uint8_t> data;
-        data.reserve(resource->size);
-        
-        for (uint32_t i = 0; i < resource->size && file.GetPosition() < file.GetLength(); ++i) {
-            data.push_back(file.ReadByteUnsigned());
-        }
-        
-        cachedData = data;
-        dataLoaded = true;
-        return data;
+        cachedData = file.ReadBytes(std::min<size_t>(resource->size, available));
+        return cachedData;
         
     } catch (const std::exception& e) {
         std::cerr << "Error reading binary data: " << e.what() << std::endl;
-        return {};
+        return cachedData;
     }
 }
 
-void BinaryResourceViewer::RenderHexDump(const std::vector<uint8_t>& data, size_t maxBytes) {
-    ImGui::Text("Hex Dump (first %zu bytes):", maxBytes);
-    
-    const size_t bytesToShow = std::min(data.size(), maxBytes);
-    const size_t bytesPerLine = 16;
-    
-    for (size_t i = 0; i < bytesToShow; i += bytesPerLine) {
-        // Hex values
-        std::string hexLine;
-        std::string asciiLine;
-        
-        for (size_t j = 0; j < bytesPerLine && (i + j) < bytesToShow; ++j) {
-            unsigned char byte = data[i + j];
-            char hexByte[4];
-            snprintf(hexByte, sizeof(hexByte), "%02X ", byte);
-            hexLine += hexByte;
-            
-            // ASCII representation
-            if (byte >= 32 && byte <= 126) {
-                asciiLine += static_cast<char>(byte);
-            } else {
-                asciiLine += '.';
-            }
-        }
-        
-        ImGui::Text("%04zX: %-48s |%s|", i, hexLine.c_str(), asciiLine.c_str());
-    }
-    
-    if (data.size() > maxBytes) {
-        ImGui::Text("... (truncated)");
+const ByteStatistics* BinaryResourceViewer::GetStatistics() {
+    if (!statistics) {
+        const std::vector<uint8_t>& data = LoadBinaryData();
+        if (data.empty()) return nullptr;
+        statistics = ResourceAnalysis::GetCached(*resource, "raw", data);
     }
+    return statistics.get();
 }
 
 void BinaryResourceViewer::RenderProperties() {
@@ -456,9 +511,10 @@ void BinaryResourceViewer::RenderProperties() {
     ImGui::Text("  MB: %.4f", resource->size / (1024.0f * 1024.0f));
     ImGui::Separator();
     
-    std::vector<uint8_t> data = LoadBinaryData();
+    const std::vector<uint8_t>& data = LoadBinaryData();
     if (!data.empty()) {
-        RenderHexDump(data);
+        hexView.SetData(&data);
+        hexView.Render("PropertiesHex", 16 * ImGui::GetTextLineHeightWithSpacing());
     } else {
         ImGui::Text("(Failed to read binary data)");
     }
@@ -478,24 +534,22 @@ void BinaryResourceViewer::RenderPreview() {
     ImGui::Text("Size: %u bytes", resource->size);
     ImGui::Separator();
     
-    std::vector<uint8_t> data = LoadBinaryData();
+    const std::vector<uint8_t>& data = LoadBinaryData();
     if (!data.empty()) {
-        ImGui::Text("Binary Data (first 256 bytes):");
-        RenderHexDump(data, 256);  // Show more data in preview
-        
-        ImGui::Separator();
         ImGui::Text("Data Analysis:");
         ImGui::Text("Total bytes: %zu", data.size());
         
-        // Count different byte values
-        std::map<uint8_t, size_t> byteCounts;
-        for (uint8_t byte : data) {
-            byteCounts[byte]++;
-        }
+        // Computed once per resource, not per frame
+        const ByteStatistics* stats = GetStatistics();
+        ImGui::Text("Unique byte values: %zu", stats->uniqueValues);
+        ImGui::Text("Most common byte: 0x%02X (%llu occurrences)", stats->modeValue,
+                    static_cast<unsigned long long>(stats->modeCount));
+        ImGui::Text("Entropy: %.3f bits/byte", stats->entropy);
+        ImGui::Separator();
         
-        ImGui::Text("Unique byte values: %zu", byteCounts.size());
-        ImGui::Text("Most common byte: 0x%02X (%zu occurrences)", 
-                   byteCounts.begin()->first, byteCounts.begin()->second);
+        // Whole resource, only visible lines are formatted
+        hexView.SetData(&data);
+        hexView.Render("PreviewHex");
     } else {
         ImGui::Text("(Failed to read binary data)");
     }
@@ -513,78 +567,19 @@ void CharResourceViewer::SetGameFilePath(const std::string& filePath) {
 }
 
 void CharResourceViewer::ClearCache() {
-    cachedDecompressedData.clear();
+    cachedTileData.clear();
     dataLoaded = false;
 }
 
-std::vector<uint8_t> CharResourceViewer::DecompressTileData() {
-    if (dataLoaded) return cachedDecompressedData;
+const std::vector<uint8_t>& CharResourceViewer::LoadTileData() {
+    if (dataLoaded) return cachedTileData;
+    dataLoaded = true;
     
-    try {
-        if (resource->sourceFile.empty()) {
-            return {};
-        }
-        
-        BinaryFile file(resource->sourceFile);
-        if (!file.IsOpen()) {
-            return {};
-        }
-        
-        // CHAR specific: DataStartOffset = offset + 4, read all tiles
-        uint32_t dataStartOffset = resource->offset + 4;
-        uint32_t expectedSize = TILE_COUNT * TILE_BYTES;
-        
-        if (dataStartOffset >= file.GetLength()) {
-            return {};
-        }
-        
-        file.SetPosition(dataStartOffset);
-        
-        // Read all tile data
-        std::vector<uint8_t> tileData;
-        tileData.reserve(expectedSize);
-        
-        for (uint32_t i = 0; i < expectedSize && file.GetPosition() < file.GetLength(); ++i) {
-            tileData.push_back(file.ReadByteUnsigned());
-        }
-        
-        cachedDecompressedData = tileData;
-        dataLoaded = true;
-        return tileData;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error reading tile data: " << e.what() << std::endl;
-        return {};
-    }
-}
-
-std::vector<uint8_t> CharResourceViewer::DecodeTile(const std::vector<uint8_t>& tileData, size_t tileIndex) {
-    std::vector<uint8_t> decodedTile(TILE_SIZE * TILE_SIZE, 0);
-    
-    size_t tileOffset = tileIndex * TILE_BYTES;
-    if (tileOffset + TILE_BYTES > tileData.size()) {
-        return decodedTile;
+    if (!resource->sourceFile.empty()) {
+        ScopedTimer timer("CharViewer: read tiles");
+        cachedTileData = ResourceDecoders::ReadTileData(resource->sourceFile, resource->offset);
     }
-    
-    // Decode 4bpp tile data (2 pixels per byte)
-    size_t pixelIndex = 0;
-    for (size_t i = 0; i < TILE_BYTES && pixelIndex < TILE_SIZE * TILE_SIZE; ++i) {
-        uint8_t byte = tileData[tileOffset + i];
-        uint8_t pixel1 = byte & 0x0F;  // Lower nibble
-        uint8_t pixel2 = (byte >> 4) & 0x0F;  // Upper nibble
-        
-        decodedTile[pixelIndex++] = pixel1;
-        if (pixelIndex < TILE_SIZE * TILE_SIZE) {
-            decodedTile[pixelIndex++] = pixel2;
-        }
-    }
-    
-    return decodedTile;
-}
-
-ImU32 CharResourceViewer::GetTileColor(uint8_t pixelValue) {
-    // Use the palette to get the correct color
-    return GetPaletteColor(pixelValue);
+    return cachedTileData;
 }
 
 void CharResourceViewer::RenderProperties() {
@@ -602,7 +597,7 @@ void CharResourceViewer::RenderProperties() {
     ImGui::Text("Size: %u bytes", resource->size);
     ImGui::Separator();
     
-    std::vector<uint8_t> tileData = DecompressTileData();
+    const std::vector<uint8_t>& tileData = LoadTileData();
     if (!tileData.empty()) {
         ImGui::Text("Tile Information:");
         ImGui::Text("  Total tiles: %u", TILE_COUNT);
@@ -624,7 +619,7 @@ void CharResourceViewer::RenderPreview() {
     ImGui::Text("Tile Sheet Viewer");
     ImGui::Separator();
     
-    std::vector<uint8_t> tileData = DecompressTileData();
+    const std::vector<uint8_t>& tileData = LoadTileData();
     if (tileData.empty()) {
         ImGui::Text("(Failed to read tile data)");
         return;
@@ -642,25 +637,24 @@ void CharResourceViewer::RenderPreview() {
     ImDrawList* drawList = ImGui::GetWindowDrawList();
     
     // Draw the tile sheet
+    ScopedTimer timer("CharViewer: decode + draw tiles");
+    uint8_t decodedTile[TILE_SIZE * TILE_SIZE];
     for (int row = 0; row < tilesPerCol; ++row) {
         for (int col = 0; col < tilesPerRow; ++col) {
             int tileIndex = row * tilesPerRow + col;
             if (tileIndex < TILE_COUNT) {
-                std::vector<uint8_t> decodedTile = DecodeTile(tileData, tileIndex);
+                ResourceDecoders::DecodeTile(tileData, tileIndex, decodedTile);
                 
                 // Draw the tile
                 for (int y = 0; y < TILE_SIZE; ++y) {
                     for (int x = 0; x < TILE_SIZE; ++x) {
-                        size_t pixelIndex = y * TILE_SIZE + x;
-                        if (pixelIndex < decodedTile.size()) {
-                            ImU32 color = GetTileColor(decodedTile[pixelIndex]);
-                            ImVec2 p0 = ImVec2(
-                                canvasPos.x + (col * TILE_SIZE + x) * tileScale,
-                                canvasPos.y + (row * TILE_SIZE + y) * tileScale
-                            );
-                            ImVec2 p1 = ImVec2(p0.x + tileScale, p0.y + tileScale);
-                            drawList->AddRectFilled(p0, p1, color);
-                        }
+                        ImU32 color = ResourceDecoders::GetPaletteColor(decodedTile[y * TILE_SIZE + x]);
+                        ImVec2 p0 = ImVec2(
+                            canvasPos.x + (col * TILE_SIZE + x) * tileScale,
+                            canvasPos.y + (row * TILE_SIZE + y) * tileScale
+                        );
+                        ImVec2 p1 = ImVec2(p0.x + tileScale, p0.y + tileScale);
+                        drawList->AddRectFilled(p0, p1, color);
                     }
                 }
             }
@@ -680,108 +674,253 @@ void CharResourceViewer::RenderPreview() {
 
 
 
-// Static member initialization
-std::vector<ImU32> MapResourceViewer::cachedMapImage;
-std::vector<uint8_t> MapResourceViewer::lastMapData;
-std::vector<uint8_t> MapResourceViewer::lastTileData;
-bool MapResourceViewer::imageValid = false;
+// FormResourceViewer implementation
+void FormResourceViewer::SetResource(const std::shared_ptr<ResourceItem>& resource) {
+    this->resource = resource;
+    ClearCache();
+}
 
-void MapResourceViewer::RenderMapWithTiles(const std::vector<uint8_t>& mapData, const std::vector<uint8_t>& tileData) {
-    if (mapData.empty() || tileData.empty()) {
-        ImGui::Text("(No map data or tile data available)");
+void FormResourceViewer::SetGameFilePath(const std::string& filePath) {
+    gameFilePath = filePath;
+}
+
+void FormResourceViewer::ClearCache() {
+    player.Stop();
+    playbackStarted = false;
+    cachedData.reset();
+    frameCount = frameWidth = frameHeight = 0;
+    dataLoaded = false;
+}
+
+size_t FormResourceViewer::GetFrameBytes() const {
+    // Each row holds one word-aligned line per bitplane (interleaved, as in the map data)
+    return ResourceDecoders::PlanarImageBytes(frameWidth, frameHeight, bitplanes);
+}
+
+bool FormResourceViewer::ParseFrameHeader(const std::vector<uint8_t>& data) {
+    if (data.size() < HEADER_BYTES) return false;
+
+    // The header words follow the platform's data endianness, which the item does not record.
+    // Take whichever byte order yields a geometry that fits inside the chunk.
+    for (Endianness endian : {Endianness::Little, Endianness::Big}) {
+        uint16_t count = static_cast<uint16_t>(BinaryFile::ReadShort(data[4], data[5], endian));
+        uint16_t w = static_cast<uint16_t>(BinaryFile::ReadShort(data[6], data[7], endian));
+        uint16_t h = static_cast<uint16_t>(BinaryFile::ReadShort(data[8], data[9], endian));
+        if (count == 0 || w == 0 || h == 0 || w > 1024 || h > 1024) continue;
+
+        frameCount = count;
+        frameWidth = w;
+        frameHeight = h;
+        if (HEADER_BYTES + frameCount * GetFrameBytes() <= data.size()) {
+            return true;
+        }
+    }
+
+    frameCount = frameWidth = frameHeight = 0;
+    return false;
+}
+
+bool FormResourceViewer::LoadFormData() {
+    if (dataLoaded) return frameCount > 0;
+    dataLoaded = true;
+
+    try {
+        if (resource->sourceFile.empty()) {
+            return false;
+        }
+
+        BinaryFile file(resource->sourceFile);
+        if (!file.IsOpen() || resource->offset >= file.GetLength()) {
+            return false;
+        }
+
+        size_t available = file.GetLength() - resource->offset;
+        file.SetPosition(resource->offset);
+        auto data = std::make_shared<std::vector<uint8_t>>(file.ReadBytes(std::min<size_t>(resource->size, available)));
+        cachedData = data;
+        return ParseFrameHeader(*data);
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading form data: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void FormResourceViewer::StartPlayback() {
+    playbackStarted = true;
+    if (!LoadFormData()) {
+        player.Stop();
         return;
     }
-    
-    ImGui::Text("Map with Actual Tiles:");
+
+    auto data = cachedData;
+    const size_t frameBytes = GetFrameBytes();
+    const uint32_t w = frameWidth, h = frameHeight, planes = bitplanes;
+    player.Start(frameCount, frameWidth, frameHeight,
+                 TICKS_PER_FRAME / NATIVE_TICK_RATE / playbackSpeed,
+                 [data, frameBytes, w, h, planes](size_t frame, std::vector<uint32_t>& pixels) {
+                     ScopedTimer timer("FormViewer: decode frame");
+                     size_t frameOffset = HEADER_BYTES + frame * frameBytes;
+                     IndexedImage indices;
+                     if (frameOffset > data->size() ||
+                         !ResourceDecoders::DecodePlanar(data->data() + frameOffset, data->size() - frameOffset, w, h, planes, indices)) {
+                         return false;
+                     }
+                     ResourceDecoders::ExpandPalette(indices, pixels);
+                     return true;
+                 });
+}
+
+void FormResourceViewer::RenderProperties() {
+    if (!resource) {
+        ImGui::Text("No resource selected");
+        return;
+    }
+
+    ImGui::Text("Form Resource Properties");
     ImGui::Separator();
-    
-    // Check if we need to regenerate the image
-    if (!imageValid || mapData != lastMapData || tileData != lastTileData) {
-        RenderMapToImage(mapData, tileData);
-        lastMapData = mapData;
-        lastTileData = tileData;
-        imageValid = true;
-    }
-    
-    // Display the cached image
-    if (!cachedMapImage.empty()) {
-        const int imageWidth = mapGridWidth * TILE_SIZE;
-        const int imageHeight = mapGridHeight * TILE_SIZE;
-        const int scale = 4; // 4x scale
-        ImVec2 canvasPos = ImGui::GetCursorScreenPos();
-        ImDrawList* drawList = ImGui::GetWindowDrawList();
-        
-        // Draw the cached image pixels at 4x size
-        for (int y = 0; y < imageHeight; ++y) {
-            for (int x = 0; x < imageWidth; ++x) {
-                size_t imageIndex = y * imageWidth + x;
-                if (imageIndex < cachedMapImage.size()) {
-                    ImU32 color = cachedMapImage[imageIndex];
-                    ImVec2 p0 = ImVec2(canvasPos.x + x * scale, canvasPos.y + y * scale);
-                    ImVec2 p1 = ImVec2(p0.x + scale, p0.y + scale);
-                    drawList->AddRectFilled(p0, p1, color);
-                }
+
+    ImGui::Text("Name: %s", resource->name.c_str());
+    ImGui::Text("Type: Form/Animation (FRML)");
+    ImGui::Text("Offset: 0x%08X", resource->offset);
+    ImGui::Text("Size: %u bytes", resource->size);
+    ImGui::Separator();
+
+    if (LoadFormData()) {
+        ImGui::Text("Animation Information:");
+        ImGui::Text("  Frames: %u", frameCount);
+        ImGui::Text("  Frame size: %ux%u pixels", frameWidth, frameHeight);
+        ImGui::Text("  Bitplanes: %d", bitplanes);
+        ImGui::Text("  Bytes per frame: %zu", GetFrameBytes());
+        ImGui::Text("  Frame time: %.0f ms", 1000.0 * TICKS_PER_FRAME / NATIVE_TICK_RATE);
+    } else {
+        ImGui::Text("(Failed to read frame header)");
+    }
+}
+
+void FormResourceViewer::RenderPreview() {
+    if (!resource) {
+        ImGui::Text("No resource selected");
+        return;
+    }
+
+    ImGui::Text("Animation Viewer");
+    ImGui::Separator();
+
+    if (!playbackStarted) {
+        StartPlayback();
+    }
+    if (frameCount == 0) {
+        ImGui::Text("(Failed to read frame header)");
+        if (cachedData) {
+            ImGui::SetNextItemWidth(100);
+            if (ImGui::SliderInt("Bitplanes", &bitplanes, 1, 5)) {
+                ParseFrameHeader(*cachedData);
+                StartPlayback();
             }
         }
-        
-        // Reserve space in ImGui layout for the drawn area
-        ImGui::Dummy(ImVec2(imageWidth * scale, imageHeight * scale));
-    }
-}
-
-void MapResourceViewer::RenderMapToImage(const std::vector<uint8_t>& mapData, const std::vector<uint8_t>& tileData) {
-    // Pre-decode all tiles once
-    std::vector<std::vector<uint8_t>> tileCache;
-    tileCache.reserve(256);
-    for (int i = 0; i < 256; ++i) {
-        tileCache.push_back(CharResourceViewer::DecodeTile(tileData, i));
-    }
-    
-    // Create image buffer (16x16 pixels per map tile)
-    const int imageWidth = mapGridWidth * TILE_SIZE;
-    const int imageHeight = mapGridHeight * TILE_SIZE;
-    cachedMapImage.clear();
-    cachedMapImage.resize(imageWidth * imageHeight, IM_COL32(0, 0, 0, 255)); // Initialize with black
-    
-    // Render map to image buffer (16x16 pixels per tile)
-    for (uint32_t mapRow = 0; mapRow < mapGridHeight; ++mapRow) {
-        for (uint32_t mapCol = 0; mapCol < mapGridWidth; ++mapCol) {
-            size_t mapIndex = mapRow * mapGridWidth + mapCol;
-            if (mapIndex < mapData.size()) {
-                uint8_t tileIndex = mapData[mapIndex];
-                if (tileIndex < 256 && tileIndex < tileCache.size()) {
-                    const std::vector<uint8_t>& decodedTile = tileCache[tileIndex];
-                    
-                    // Calculate the position of this tile in the image
-                    int imageStartX = mapCol * TILE_SIZE;
-                    int imageStartY = mapRow * TILE_SIZE;
-                    
-                    // Render the full 16x16 tile
-                    for (int tileY = 0; tileY < TILE_SIZE; ++tileY) {
-                        for (int tileX = 0; tileX < TILE_SIZE; ++tileX) {
-                            size_t pixelIndex = tileY * TILE_SIZE + tileX;
-                            if (pixelIndex < decodedTile.size()) {
-                                uint8_t pixelValue = decodedTile[pixelIndex];
-                                ImU32 color = CharResourceViewer::GetTileColor(pixelValue);
-                                
-                                // Calculate the position in the image buffer
-                                int imageX = imageStartX + tileX;
-                                int imageY = imageStartY + tileY;
-                                size_t imageIndex = imageY * imageWidth + imageX;
-                                
-                                if (imageIndex < cachedMapImage.size()) {
-                                    cachedMapImage[imageIndex] = color;
-                                }
-                            }
-                        }
-                    }
-                }
+        return;
+    }
+
+    player.Update(ImGui::GetIO().DeltaTime);
+
+    if (ImGui::Button(player.IsPlaying() ? "Pause" : "Play")) {
+        player.SetPlaying(!player.IsPlaying());
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(150);
+    if (ImGui::SliderFloat("Speed", &playbackSpeed, 0.25f, 4.0f, "%.2fx")) {
+        player.SetFrameDuration(TICKS_PER_FRAME / NATIVE_TICK_RATE / playbackSpeed);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100);
+    if (ImGui::SliderInt("Bitplanes", &bitplanes, 1, 5)) {
+        // Frame stride depends on the plane count
+        ParseFrameHeader(*cachedData);
+        StartPlayback();
+    }
+    ImGui::SetNextItemWidth(150);
+    ImGui::SliderInt("Scale", &displayScale, 1, 8);
+
+    ImGui::Text("Frame %zu / %u", player.GetCurrentFrame() + 1, frameCount);
+    ImGui::SameLine();
+    ImGui::TextDisabled("(%zu frames resident, %zu late)", std::min<size_t>(AnimationPlayer::RING_SIZE, frameCount), player.GetDroppedFrames());
+    ImGui::Separator();
+
+    ImVec2 size(static_cast<float>(frameWidth * displayScale), static_cast<float>(frameHeight * displayScale));
+    if (player.HasFrame()) {
+        ImGui::Image(player.GetTexture(), size);
+    } else {
+        ImGui::Dummy(size);
+    }
+}
+
+void MapResourceViewer::RenderMapWithTiles(const std::vector<uint8_t>& mapData, const Tileset& tiles) {
+    if (mapData.empty() || tiles.atlas.empty()) {
+        ImGui::Text("(No map data or tile data available)");
+        return;
+    }
+    
+    if (!tileAtlas.IsValid()) {
+        tileAtlas.Upload(tiles.atlas.data(), ResourceDecoders::ATLAS_SIZE, ResourceDecoders::ATLAS_SIZE);
+    }
+    
+    ImGui::Text("Tileset: %s", tiles.source->name.c_str());
+    if (ImGui::Button("Fit")) {
+        viewport.FitToView();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("1:1")) {
+        viewport.SetZoom(1.0f);
+    }
+    ImGui::SameLine();
+    ImGui::Text("Zoom: %.0f%%  (wheel to zoom, drag to pan)", viewport.GetZoom() * 100.0f);
+    
+    // Keep the statistics lines below the viewport visible
+    const float footerHeight = ImGui::GetTextLineHeightWithSpacing() * 4 + ImGui::GetStyle().ItemSpacing.y * 2;
+    ImGui::BeginChild("MapViewportHost", ImVec2(0, -footerHeight));
+    viewport.Begin("MapViewport", static_cast<float>(mapGridWidth * TILE_SIZE), static_cast<float>(mapGridHeight * TILE_SIZE));
+    size_t cellCount = std::min<size_t>(mapData.size() / mapGridWidth, mapGridHeight);
+    ScopedTimer drawTimer("MapViewer: draw tiles");
+    viewport.DrawTiles(tileAtlas, ResourceDecoders::ATLAS_COLUMNS, mapData.data(), mapGridWidth, static_cast<uint32_t>(cellCount), TILE_SIZE);
+    viewport.End();
+    ImGui::EndChild();
+    
+    if (viewport.IsHovered()) {
+        ImVec2 pos = viewport.GetHoveredContentPos();
+        if (pos.x >= 0 && pos.y >= 0) {
+            uint32_t col = static_cast<uint32_t>(pos.x) / TILE_SIZE;
+            uint32_t row = static_cast<uint32_t>(pos.y) / TILE_SIZE;
+            size_t index = static_cast<size_t>(row) * mapGridWidth + col;
+            if (col < mapGridWidth && row < mapGridHeight && index < mapData.size()) {
+                ImGui::SetTooltip("Cell %u,%u: tile 0x%02X", col, row, mapData[index]);
             }
         }
     }
 }
 
-
+void MapResourceViewer::RenderMapCells(const std::vector<uint8_t>& mapData) {
+    const float footerHeight = ImGui::GetTextLineHeightWithSpacing() * 4 + ImGui::GetStyle().ItemSpacing.y * 2;
+    ImGui::BeginChild("MapViewportHost", ImVec2(0, -footerHeight));
+    viewport.Begin("MapViewport", static_cast<float>(mapGridWidth * TILE_SIZE), static_cast<float>(mapGridHeight * TILE_SIZE));
+    
+    uint32_t x0, y0, x1, y1;
+    viewport.GetVisibleCells(mapGridWidth, mapGridHeight, TILE_SIZE, x0, y0, x1, y1);
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    for (uint32_t row = y0; row < y1; ++row) {
+        for (uint32_t col = x0; col < x1; ++col) {
+            size_t index = static_cast<size_t>(row) * mapGridWidth + col;
+            if (index >= mapData.size()) break;
+            uint8_t value = mapData[index];
+            ImVec2 p0 = viewport.ContentToScreen(static_cast<float>(col * TILE_SIZE), static_cast<float>(row * TILE_SIZE));
+            ImVec2 p1 = viewport.ContentToScreen(static_cast<float>((col + 1) * TILE_SIZE), static_cast<float>((row + 1) * TILE_SIZE));
+            drawList->AddRectFilled(p0, p1, IM_COL32(value, value, value, 255));
+        }
+    }
+    
+    viewport.End();
+    ImGui::EndChild();
+}
 
 // Helper function for resource type strings
 const char* GetResourceTypeString(ResourceType type) {
@@ -795,31 +934,4 @@ const char* GetResourceTypeString(ResourceType type) {
         case ResourceType::ARCHIVE: return "Archive";
         default: return "Unknown";
     }
-} 
-
-// Static method implementation for CharResourceViewer
-std::vector<uint8_t> CharResourceViewer::GetTileData(const std::string& sourceFile, uint32_t offset) {
-    constexpr uint32_t TILE_COUNT = 256;
-    constexpr uint32_t TILE_BYTES = 128;
-    try {
-        BinaryFile file(sourceFile);
-        if (!file.IsOpen()) {
-            return {};
-        }
-        uint32_t dataStartOffset = offset + 4;
-        uint32_t expectedSize = TILE_COUNT * TILE_BYTES;
-        if (dataStartOffset >= file.GetLength()) {
-            return {};
-        }
-        file.SetPosition(dataStartOffset);
-        std::vector<uint8_t> tileData;
-        tileData.reserve(expectedSize);
-        for (uint32_t i = 0; i < expectedSize && file.GetPosition() < file.GetLength(); ++i) {
-            tileData.push_back(file.ReadByteUnsigned());
-        }
-        return tileData;
-    } catch (const std::exception& e) {
-        std::cerr << "Error reading tile data: " << e.what() << std::endl;
-        return {};
-    }
-} 
\ No newline at end of file
+}
@@ -0,0 +1,347 @@
+#include "ResourceWriter.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#else
+#include <random>
+#endif
+
+namespace {
+    uint32_t Get32(const std::vector<uint8_t>& bytes, size_t pos, Endianness endian) {
+        if (pos + 4 > bytes.size()) throw std::runtime_error("Unexpected end of file at " + std::to_string(pos));
+        const uint8_t* p = bytes.data() + pos;
+        return endian == Endianness::Little
+            ? (uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24)
+            : (uint32_t(p[3]) | uint32_t(p[2]) << 8 | uint32_t(p[1]) << 16 | uint32_t(p[0]) << 24);
+    }
+
+    uint16_t Get16(const std::vector<uint8_t>& bytes, size_t pos, Endianness endian) {
+        if (pos + 2 > bytes.size()) throw std::runtime_error("Unexpected end of file at " + std::to_string(pos));
+        const uint8_t* p = bytes.data() + pos;
+        return endian == Endianness::Little ? uint16_t(p[0] | p[1] << 8) : uint16_t(p[1] | p[0] << 8);
+    }
+
+    void Put32(std::vector<uint8_t>& bytes, size_t pos, uint32_t value, Endianness endian) {
+        for (int i = 0; i < 4; ++i) {
+            int shift = endian == Endianness::Little ? 8 * i : 8 * (3 - i);
+            bytes[pos + i] = static_cast<uint8_t>(value >> shift);
+        }
+    }
+
+    void Put16(std::vector<uint8_t>& bytes, size_t pos, uint16_t value, Endianness endian) {
+        bytes[pos + (endian == Endianness::Little ? 0 : 1)] = static_cast<uint8_t>(value);
+        bytes[pos + (endian == Endianness::Little ? 1 : 0)] = static_cast<uint8_t>(value >> 8);
+    }
+
+    // Key table entry fields, at the positions ResourceLoader reads them from
+    size_t OffsetFieldPos(size_t entry, Endianness endian) { return entry + (endian == Endianness::Big ? 6 : 4); }
+    size_t MultiplierFieldPos(size_t entry, Endianness endian) { return entry + (endian == Endianness::Big ? 5 : 6); }
+
+    struct FileLayout {
+        uint32_t headerSize;
+        uint32_t dataSegmentSize;
+        std::vector<size_t> keyEntries;  // File positions of the 12-byte key table entries
+    };
+
+    // Same walk as ResourceLoader: identifiers after the data segment, then one key entry per resource
+    FileLayout ParseLayout(const std::vector<uint8_t>& bytes, Endianness endian) {
+        FileLayout layout;
+        layout.headerSize = Get32(bytes, 0, endian);
+        layout.dataSegmentSize = Get32(bytes, 4, endian);
+
+        size_t trailer = static_cast<size_t>(layout.headerSize) + layout.dataSegmentSize;
+        uint32_t chunkTypeQty = Get16(bytes, trailer + 12, endian) + 1u;
+        size_t keyPosition = trailer + 14 + 8 * static_cast<size_t>(chunkTypeQty);
+
+        size_t entryCount = 0;
+        for (uint32_t i = 0; i < chunkTypeQty; ++i) {
+            size_t identifier = trailer + 14 + 8 * static_cast<size_t>(i);
+            if (identifier + 4 > bytes.size() || Get32(bytes, identifier, Endianness::Big) == 0) break;
+            entryCount += Get16(bytes, identifier + 4, endian) + 1u;
+        }
+        for (size_t i = 0; i < entryCount; ++i) {
+            size_t entry = keyPosition + ResourceWriter::KEY_ENTRY_SIZE * i;
+            if (entry + ResourceWriter::KEY_ENTRY_SIZE > bytes.size()) break;
+            layout.keyEntries.push_back(entry);
+        }
+        return layout;
+    }
+
+    // Creates an empty file next to filename under a name no other save uses
+    std::string CreateTempFile(const std::string& filename) {
+#ifndef _WIN32
+        std::string pattern = filename + ".XXXXXX";
+        int fd = ::mkstemp(pattern.data());
+        if (fd < 0) throw std::runtime_error("Cannot create a temporary file for " + filename);
+        ::close(fd);
+        return pattern;
+#else
+        std::random_device random;
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            std::string candidate = filename + "." + std::to_string(random()) + ".tmp";
+            if (!std::filesystem::exists(candidate)) return candidate;
+        }
+        throw std::runtime_error("Cannot create a temporary file for " + filename);
+#endif
+    }
+
+    void SyncToDisk(const std::string& path) {
+#ifndef _WIN32
+        // Read-only is enough for fsync and also opens directories, which makes a rename durable
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+#else
+        (void)path;
+#endif
+    }
+}
+
+bool ResourceWriter::SaveResourceFile(const std::string& filename, Endianness endian,
+                                      const std::vector<ResourceEdit>& edits, std::string& error) {
+    if (edits.empty()) return true;
+    std::string tempFilename;
+
+    try {
+        std::vector<uint8_t> original;
+        {
+            BinaryFile file(filename);
+            original = file.ReadBytes(file.GetLength());
+        }
+        FileLayout layout = ParseLayout(original, endian);
+        const size_t dataEnd = static_cast<size_t>(layout.headerSize) + layout.dataSegmentSize;
+
+        std::vector<ResourceEdit> sorted = edits;
+        std::sort(sorted.begin(), sorted.end(), [](const ResourceEdit& a, const ResourceEdit& b) {
+            return a.item->offset < b.item->offset;
+        });
+
+        // Refuse to write if the file no longer matches what was loaded
+        size_t previousEnd = 0;
+        for (const ResourceEdit& edit : sorted) {
+            const ResourceItem& item = *edit.item;
+            size_t chunkEnd = static_cast<size_t>(item.offset) + 4 + item.size;
+            if (item.sourceFile != filename || chunkEnd > dataEnd || item.offset < previousEnd) {
+                error = item.name + " is not a chunk inside " + filename;
+                return false;
+            }
+            if (Get32(original, item.offset, endian) != item.size) {
+                error = item.name + " has changed on disk since it was loaded";
+                return false;
+            }
+            previousEnd = chunkEnd;
+        }
+
+        // Rebuild: copy unchanged ranges, splice in new chunks, remember how far each one moved.
+        // Even when no size changes the file is never patched in place, so a crash cannot tear it.
+        std::vector<uint8_t> rebuilt;
+        rebuilt.reserve(original.size() + 4096);
+        std::vector<std::pair<uint32_t, int64_t>> shifts;  // (original chunk offset, cumulative delta after it)
+        int64_t totalDelta = 0;
+        size_t cursor = 0;
+        for (const ResourceEdit& edit : sorted) {
+            const ResourceItem& item = *edit.item;
+            if (edit.payload.size() > UINT32_MAX) throw std::runtime_error(item.name + " is too large");
+
+            rebuilt.insert(rebuilt.end(), original.begin() + cursor, original.begin() + item.offset);
+            size_t sizeField = rebuilt.size();
+            rebuilt.resize(sizeField + 4);
+            Put32(rebuilt, sizeField, static_cast<uint32_t>(edit.payload.size()), endian);
+            rebuilt.insert(rebuilt.end(), edit.payload.begin(), edit.payload.end());
+
+            // Keep later chunks on the same byte parity (68000 word alignment)
+            int64_t delta = static_cast<int64_t>(edit.payload.size()) - item.size;
+            if (delta % 2 != 0) {
+                rebuilt.push_back(0);
+                delta++;
+            }
+            totalDelta += delta;
+            shifts.emplace_back(item.offset, totalDelta);
+            cursor = static_cast<size_t>(item.offset) + 4 + item.size;
+        }
+        rebuilt.insert(rebuilt.end(), original.begin() + cursor, original.end());
+
+        auto newOffset = [&shifts](uint32_t offset) -> int64_t {
+            int64_t moved = 0;
+            for (const auto& [editOffset, delta] : shifts) {
+                if (editOffset < offset) moved = delta;
+            }
+            return offset + moved;
+        };
+
+        int64_t newSegmentSize = static_cast<int64_t>(layout.dataSegmentSize) + totalDelta;
+        if (newSegmentSize < 0 || newSegmentSize > UINT32_MAX) throw std::runtime_error("Data segment size out of range");
+        Put32(rebuilt, 4, static_cast<uint32_t>(newSegmentSize), endian);
+        // dataSize mirrors the segment size in files we write; the header probe counts on that
+        if (Get32(original, 8, endian) == layout.dataSegmentSize) {
+            Put32(rebuilt, 8, static_cast<uint32_t>(newSegmentSize), endian);
+        }
+
+        // Key table sits after the data segment, so every entry moved by totalDelta
+        for (size_t entry : layout.keyEntries) {
+            uint32_t relative = Get16(original, OffsetFieldPos(entry, endian), endian)
+                              + 65536u * original[MultiplierFieldPos(entry, endian)];
+            int64_t moved = newOffset(layout.headerSize + relative) - layout.headerSize;
+            if (moved < 0 || moved > MAX_RELATIVE_OFFSET) {
+                error = "Saving would move a chunk beyond the key table's 24-bit offset range";
+                return false;
+            }
+            size_t newEntry = static_cast<size_t>(entry + totalDelta);
+            Put16(rebuilt, OffsetFieldPos(newEntry, endian), static_cast<uint16_t>(moved & 0xFFFF), endian);
+            rebuilt[MultiplierFieldPos(newEntry, endian)] = static_cast<uint8_t>(moved >> 16);
+        }
+
+        tempFilename = CreateTempFile(filename);
+        {
+            std::ofstream out(tempFilename, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(rebuilt.data()), rebuilt.size());
+            out.close();
+            if (!out) throw std::runtime_error("Cannot write " + tempFilename);
+        }
+        // The replacement keeps the original's permissions, not the temporary file's
+        std::filesystem::permissions(tempFilename, std::filesystem::status(filename).permissions(),
+                                     std::filesystem::perm_options::replace);
+        SyncToDisk(tempFilename);
+        std::filesystem::rename(tempFilename, filename);
+        SyncToDisk(std::filesystem::absolute(filename).parent_path().string());
+        return true;
+
+    } catch (const std::exception& e) {
+        std::error_code ignored;
+        if (!tempFilename.empty()) std::filesystem::remove(tempFilename, ignored);
+        error = e.what();
+        std::cerr << "Error saving resource file: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool ResourceWriter::BuildResourceFile(Endianness endian, const std::vector<ResourceChunk>& chunks,
+                                       std::vector<uint8_t>& out, std::string& error) {
+    // Types in order of first appearance, each with the chunks that belong to it
+    std::vector<std::string> typeIDs;
+    std::vector<std::vector<size_t>> chunksByType;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (chunks[i].typeID.size() != 4) {
+            error = "Chunk type must be four characters: " + chunks[i].typeID;
+            return false;
+        }
+        auto type = std::find(typeIDs.begin(), typeIDs.end(), chunks[i].typeID);
+        if (type == typeIDs.end()) {
+            typeIDs.push_back(chunks[i].typeID);
+            chunksByType.emplace_back();
+            type = typeIDs.end() - 1;
+        }
+        chunksByType[type - typeIDs.begin()].push_back(i);
+    }
+    if (typeIDs.empty() || typeIDs.size() > 65536) {
+        error = "A resource file needs between 1 and 65536 chunk types";
+        return false;
+    }
+
+    size_t total = HEADER_SIZE;
+    for (const ResourceChunk& chunk : chunks) {
+        total += 4 + chunk.payload.size() + (chunk.payload.size() & 1);
+    }
+    total += TRAILER_PREFIX + 2 + IDENTIFIER_SIZE * typeIDs.size() + KEY_ENTRY_SIZE * chunks.size();
+    if (total > UINT32_MAX) {
+        error = "Resource file would exceed 4 GB";
+        return false;
+    }
+    out.assign(total, 0);
+
+    // Data segment
+    std::vector<uint32_t> relativeOffsets(chunks.size());
+    size_t position = HEADER_SIZE;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const ResourceChunk& chunk = chunks[i];
+        if (position - HEADER_SIZE > MAX_RELATIVE_OFFSET) {
+            error = "Chunk " + chunk.typeID + " " + std::to_string(chunk.number) + " lies beyond the key table's 24-bit offset range";
+            return false;
+        }
+        relativeOffsets[i] = static_cast<uint32_t>(position - HEADER_SIZE);
+        Put32(out, position, static_cast<uint32_t>(chunk.payload.size()), endian);
+        std::copy(chunk.payload.begin(), chunk.payload.end(), out.begin() + position + 4);
+        position += 4 + chunk.payload.size() + (chunk.payload.size() & 1);
+    }
+    const uint32_t dataSegmentSize = static_cast<uint32_t>(position - HEADER_SIZE);
+
+    // Header; dataSize and fileEndLength are not read by ResourceLoader
+    Put32(out, 0, HEADER_SIZE, endian);
+    Put32(out, 4, dataSegmentSize, endian);
+    Put32(out, 8, dataSegmentSize, endian);
+    Put32(out, 12, static_cast<uint32_t>(total - position), endian);
+
+    // Identifier list: type ID (byte-reversed on little-endian platforms) and count - 1
+    Put16(out, position + TRAILER_PREFIX, static_cast<uint16_t>(typeIDs.size() - 1), endian);
+    size_t identifier = position + TRAILER_PREFIX + 2;
+    for (size_t t = 0; t < typeIDs.size(); ++t, identifier += IDENTIFIER_SIZE) {
+        if (chunksByType[t].size() > 65536) {
+            error = "More than 65536 chunks of type " + typeIDs[t];
+            return false;
+        }
+        for (int c = 0; c < 4; ++c) {
+            out[identifier + c] = static_cast<uint8_t>(typeIDs[t][endian == Endianness::Big ? c : 3 - c]);
+        }
+        Put16(out, identifier + 4, static_cast<uint16_t>(chunksByType[t].size() - 1), endian);
+    }
+
+    // Key table, grouped by type in identifier order
+    size_t entry = identifier;
+    for (const auto& indices : chunksByType) {
+        for (size_t i : indices) {
+            Put16(out, entry, chunks[i].number, endian);
+            Put16(out, OffsetFieldPos(entry, endian), static_cast<uint16_t>(relativeOffsets[i] & 0xFFFF), endian);
+            out[MultiplierFieldPos(entry, endian)] = static_cast<uint8_t>(relativeOffsets[i] >> 16);
+            entry += KEY_ENTRY_SIZE;
+        }
+    }
+    return true;
+}
+
+bool ResourceWriter::WriteResourceFile(const std::string& filename, Endianness endian,
+                                       const std::vector<ResourceChunk>& chunks, std::string& error) {
+    std::vector<uint8_t> bytes;
+    if (!BuildResourceFile(endian, chunks, bytes, error)) return false;
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+        error = "Cannot write " + filename;
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint8_t> ResourceWriter::EncodeByteRun(const uint8_t* data, size_t size) {
+    std::vector<uint8_t> out;
+    out.reserve(size + size / 128 + 1);
+    size_t i = 0;
+    while (i < size) {
+        size_t run = 1;
+        while (i + run < size && run < 128 && data[i + run] == data[i]) ++run;
+        if (run >= 3) {
+            out.push_back(static_cast<uint8_t>(-static_cast<int>(run - 1)));
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+        // Literal bytes up to the next repeat of three or more
+        size_t start = i;
+        while (i < size && i - start < 128) {
+            if (i + 2 < size && data[i] == data[i + 1] && data[i] == data[i + 2]) break;
+            ++i;
+        }
+        out.push_back(static_cast<uint8_t>(i - start - 1));
+        out.insert(out.end(), data + start, data + i);
+    }
+    return out;
+}
@@ -0,0 +1,226 @@
+#include "SearchWindow.h"
+#include "FrameScheduler.h"
+#include <imgui.h>
+#include <chrono>
+#include <filesystem>
+
+SearchWindow::SearchWindow()
+    : currentGame(nullptr)
+    , hasGame(false) {
+}
+
+SearchWindow::~SearchWindow() {
+    CancelSearch();
+}
+
+void SearchWindow::SetGame(const Game* game) {
+    CancelSearch();
+    currentGame = game;
+    hasGame = (game != nullptr);
+    results.clear();
+    selectedHit = -1;
+    status.clear();
+    textResults.clear();
+    selectedTextHit = -1;
+}
+
+void SearchWindow::ClearGame() {
+    SetGame(nullptr);
+}
+
+void SearchWindow::SetOnHitSelected(std::function<void(const std::shared_ptr<ResourceItem>&, size_t, size_t)> callback) {
+    onHitSelected = callback;
+}
+
+void SearchWindow::CancelSearch() {
+    if (progress) progress->cancel = true;
+    if (worker.joinable()) worker.join();
+    running = false;
+}
+
+void SearchWindow::StartSearch() {
+    CancelSearch();
+    if (!hasGame || !currentGame->resource) return;
+
+    SearchQuery query;
+    if (queryIsHex) {
+        if (!ResourceSearch::ParseHexPattern(queryBuffer, query.pattern)) {
+            status = "Invalid hex pattern";
+            return;
+        }
+    } else {
+        for (const char* c = queryBuffer; *c; ++c) {
+            query.pattern.push_back(static_cast<uint8_t>(*c));
+        }
+        query.ignoreCase = ignoreCase;
+    }
+    if (query.pattern.empty()) return;
+
+    patternLength = query.pattern.size();
+    results.clear();
+    selectedHit = -1;
+    status = "Searching...";
+    progress = std::make_unique<SearchProgress>();
+    running = true;
+
+    // The worker gets its own copy of the item list so the index can change underneath it
+    std::vector<std::shared_ptr<ResourceItem>> items = currentGame->resource->items;
+    SearchProgress* searchProgress = progress.get();
+    worker = std::thread([this, items = std::move(items), query, searchProgress]() {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<SearchHit> hits = ResourceSearch::Search(items, query, searchProgress);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(resultMutex);
+        pendingResults = std::move(hits);
+        resultsReady = true;
+        status = std::to_string(pendingResults.size()) + " hits in " + std::to_string(static_cast<int>(ms)) + " ms";
+        if (searchProgress->cancel) status = "Cancelled";
+        running = false;
+        FrameScheduler::Wake();
+    });
+}
+
+void SearchWindow::Render() {
+    if (ImGui::Begin("Search", nullptr)) {
+        if (!hasGame) {
+            ImGui::Text("No game loaded");
+            ImGui::End();
+            return;
+        }
+
+        if (ImGui::BeginTabBar("SearchModes")) {
+            if (ImGui::BeginTabItem("Bytes")) {
+                RenderByteSearch();
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Strings")) {
+                RenderTextSearch();
+                ImGui::EndTabItem();
+            }
+            ImGui::EndTabBar();
+        }
+    }
+    ImGui::End();
+}
+
+void SearchWindow::RenderByteSearch() {
+    bool submit = ImGui::InputText("##query", queryBuffer, sizeof(queryBuffer), ImGuiInputTextFlags_EnterReturnsTrue);
+    ImGui::SameLine();
+    submit |= ImGui::Button("Find");
+    ImGui::Checkbox("Hex", &queryIsHex);
+    ImGui::SameLine();
+    ImGui::BeginDisabled(queryIsHex);
+    ImGui::Checkbox("Ignore case", &ignoreCase);
+    ImGui::EndDisabled();
+    if (submit) StartSearch();
+
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        if (resultsReady) {
+            results = std::move(pendingResults);
+            pendingResults.clear();
+            resultsReady = false;
+        }
+        if (running && progress) {
+            FrameScheduler::RequestRedrawIn(FrameScheduler::PROGRESS_INTERVAL);
+            uint64_t total = progress->bytesTotal;
+            float fraction = total ? static_cast<float>(progress->bytesScanned) / total : 0.0f;
+            ImGui::ProgressBar(fraction, ImVec2(-80.0f, 0.0f));
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel")) progress->cancel = true;
+        } else if (!status.empty()) {
+            ImGui::Text("%s", status.c_str());
+        }
+    }
+
+    ImGui::Separator();
+    RenderResults();
+}
+
+void SearchWindow::RenderResults() {
+    if (results.empty()) return;
+
+    ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable;
+    if (!ImGui::BeginTable("SearchResults", 3, flags)) return;
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Resource");
+    ImGui::TableSetupColumn("File");
+    ImGui::TableSetupColumn("Offset");
+    ImGui::TableHeadersRow();
+
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(results.size()));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const SearchHit& hit = results[row];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::PushID(row);
+            if (ImGui::Selectable(hit.item->name.c_str(), selectedHit == row, ImGuiSelectableFlags_SpanAllColumns)) {
+                selectedHit = row;
+                if (onHitSelected) {
+                    onHitSelected(hit.item, hit.offset, patternLength);
+                }
+            }
+            ImGui::PopID();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(std::filesystem::path(hit.item->sourceFile).filename().string().c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("0x%06X (file 0x%08X)", hit.offset, hit.item->offset + hit.offset);
+        }
+    }
+    ImGui::EndTable();
+}
+
+void SearchWindow::RunTextQuery() {
+    textResults = stringIndex ? stringIndex->Query(textQueryBuffer) : std::vector<StringMatch>();
+    selectedTextHit = -1;
+}
+
+void SearchWindow::RenderTextSearch() {
+    if (!stringIndex) return;
+
+    // The index answers in milliseconds, so search as the user types
+    bool changed = ImGui::InputTextWithHint("##textquery", "words, \"a phrase\", prefix*", textQueryBuffer, sizeof(textQueryBuffer));
+    bool building = stringIndex->IsBuilding();
+    if (changed || (textIndexWasBuilding && !building)) RunTextQuery();
+    textIndexWasBuilding = building;
+
+    if (building) {
+        ImGui::Text("Indexing strings...");
+    } else {
+        ImGui::Text("%zu strings indexed, %zu matches", stringIndex->GetDocumentCount(), textResults.size());
+    }
+    ImGui::Separator();
+
+    if (textResults.empty()) return;
+    ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable;
+    if (!ImGui::BeginTable("TextResults", 2, flags)) return;
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Resource");
+    ImGui::TableSetupColumn("Text");
+    ImGui::TableHeadersRow();
+
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(textResults.size()));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const StringMatch& match = textResults[row];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::PushID(row);
+            if (ImGui::Selectable(match.item->name.c_str(), selectedTextHit == row, ImGuiSelectableFlags_SpanAllColumns)) {
+                selectedTextHit = row;
+                if (onHitSelected) {
+                    // Text starts after the chunk's 4-byte length
+                    onHitSelected(match.item, match.offset + 4, match.length);
+                }
+            }
+            ImGui::PopID();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(match.snippet.c_str());
+        }
+    }
+    ImGui::EndTable();
+}
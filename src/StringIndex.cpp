@@ -0,0 +1,367 @@
+#include "StringIndex.h"
+#include "BinaryFile.h"
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <set>
+
+namespace {
+    struct Word {
+        std::string text;  // Lower-cased
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    inline bool IsWordChar(unsigned char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    std::vector<Word> Tokenize(const std::string& text) {
+        std::vector<Word> words;
+        size_t i = 0;
+        while (i < text.size()) {
+            while (i < text.size() && !IsWordChar(static_cast<unsigned char>(text[i]))) ++i;
+            size_t start = i;
+            while (i < text.size() && IsWordChar(static_cast<unsigned char>(text[i]))) ++i;
+            if (i > start) {
+                Word word{text.substr(start, i - start), static_cast<uint32_t>(start), static_cast<uint32_t>(i - start)};
+                for (char& c : word.text) {
+                    if (c >= 'A' && c <= 'Z') c = static_cast<char>(c | 0x20);
+                }
+                words.push_back(std::move(word));
+            }
+        }
+        return words;
+    }
+
+    // One query term: a single word or a quoted phrase
+    struct Clause {
+        std::vector<std::string> words;
+        bool lastIsPrefix = false;
+    };
+
+    std::vector<Clause> ParseQuery(const std::string& query) {
+        std::vector<Clause> clauses;
+        auto addClause = [&clauses](const std::string& text) {
+            Clause clause;
+            for (Word& word : Tokenize(text)) clause.words.push_back(std::move(word.text));
+            if (clause.words.empty()) return;
+            size_t last = text.find_last_not_of(" \t");
+            clause.lastIsPrefix = last != std::string::npos && text[last] == '*';
+            clauses.push_back(std::move(clause));
+        };
+
+        size_t i = 0;
+        while (i < query.size()) {
+            if (query[i] == '"') {
+                size_t close = query.find('"', i + 1);
+                if (close == std::string::npos) close = query.size();
+                addClause(query.substr(i + 1, close - i - 1));
+                i = close + 1;
+            } else if (query[i] == ' ' || query[i] == '\t') {
+                ++i;
+            } else {
+                size_t end = query.find_first_of(" \t\"", i);
+                if (end == std::string::npos) end = query.size();
+                addClause(query.substr(i, end - i));
+                i = end;
+            }
+        }
+        return clauses;
+    }
+
+    bool ReadFrom(BinaryFile& file, const ResourceItem& item, std::string& text) {
+        // Text starts after the 4-byte chunk length, as in StringResourceViewer
+        size_t start = static_cast<size_t>(item.offset) + 4;
+        size_t length = file.GetLength();
+        if (start >= length) return false;
+        file.SetPosition(start);
+        std::vector<uint8_t> bytes = file.ReadBytes(std::min<size_t>(item.size, length - start));
+        text.assign(bytes.begin(), bytes.end());
+        return true;
+    }
+}
+
+StringIndex::~StringIndex() {
+    StopWorker();
+}
+
+bool StringIndex::ReadStringResource(const ResourceItem& item, std::string& text) {
+    if (item.sourceFile.empty()) return false;
+    try {
+        BinaryFile file(item.sourceFile);
+        return file.IsOpen() && ReadFrom(file, item, text);
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading string data: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void StringIndex::StopWorker() {
+    cancel = true;
+    if (worker.joinable()) worker.join();
+    cancel = false;
+    building = false;
+}
+
+void StringIndex::Clear() {
+    StopWorker();
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    data = Data();
+    pendingUpdates.clear();
+    pendingRemovals.clear();
+    ++generation;
+}
+
+void StringIndex::BuildAsync(const std::vector<std::shared_ptr<ResourceItem>>& items) {
+    StopWorker();
+
+    std::vector<std::shared_ptr<ResourceItem>> strings;
+    for (const auto& item : items) {
+        if (item->type == ResourceType::CSTR) strings.push_back(item);
+    }
+    // Read file by file so each .res is opened once; documents keep index order
+    std::vector<size_t> readOrder(strings.size());
+    for (size_t i = 0; i < readOrder.size(); ++i) readOrder[i] = i;
+    std::stable_sort(readOrder.begin(), readOrder.end(), [&strings](size_t a, size_t b) {
+        return strings[a]->sourceFile < strings[b]->sourceFile;
+    });
+
+    uint64_t buildGeneration;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        data = Data();
+        pendingUpdates.clear();
+        pendingRemovals.clear();
+        buildGeneration = ++generation;
+    }
+
+    building = true;
+    worker = std::thread([this, strings = std::move(strings), readOrder = std::move(readOrder), buildGeneration]() {
+        std::vector<std::string> texts(strings.size());
+        std::vector<bool> loaded(strings.size(), false);
+        std::unique_ptr<BinaryFile> file;
+        for (size_t i : readOrder) {
+            if (cancel) break;
+            const ResourceItem& item = *strings[i];
+            try {
+                if (!file || file->GetFilename() != item.sourceFile) {
+                    file.reset();
+                    if (item.sourceFile.empty()) continue;
+                    file = std::make_unique<BinaryFile>(item.sourceFile);
+                }
+                loaded[i] = file->IsOpen() && ReadFrom(*file, item, texts[i]);
+            } catch (const std::exception& e) {
+                std::cerr << "String index: " << e.what() << std::endl;
+                file.reset();
+            }
+        }
+
+        Data built;
+        for (size_t i = 0; i < strings.size() && !cancel; ++i) {
+            if (loaded[i]) AddDocument(built, strings[i], std::move(texts[i]));
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (!cancel && generation == buildGeneration) {
+            data = std::move(built);
+            for (auto& [item, text] : pendingUpdates) {
+                AddDocument(data, item, std::move(text));
+            }
+            for (const auto& item : pendingRemovals) {
+                RemoveItem(data, item.get());
+            }
+        }
+        pendingUpdates.clear();
+        pendingRemovals.clear();
+        building = false;
+    });
+}
+
+size_t StringIndex::GetDocumentCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    // Removed documents leave empty slots behind
+    return data.documentByItem.size();
+}
+
+void StringIndex::Update(const std::shared_ptr<ResourceItem>& item, const std::string& text) {
+    if (!item || item->type != ResourceType::CSTR) return;
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (building) {
+        // Applied on top of the new index when the build finishes
+        pendingUpdates.emplace_back(item, text);
+        return;
+    }
+    AddDocument(data, item, text);
+}
+
+void StringIndex::Replace(const std::vector<std::shared_ptr<ResourceItem>>& removed,
+                          const std::vector<std::shared_ptr<ResourceItem>>& added) {
+    // Read before locking, so queries are not held up by the file
+    std::vector<std::pair<std::shared_ptr<ResourceItem>, std::string>> texts;
+    std::unique_ptr<BinaryFile> file;
+    for (const auto& item : added) {
+        if (item->type != ResourceType::CSTR || item->sourceFile.empty()) continue;
+        try {
+            if (!file || file->GetFilename() != item->sourceFile) {
+                file = std::make_unique<BinaryFile>(item->sourceFile);
+            }
+            std::string text;
+            if (file->IsOpen() && ReadFrom(*file, *item, text)) texts.emplace_back(item, std::move(text));
+        } catch (const std::exception& e) {
+            std::cerr << "String index: " << e.what() << std::endl;
+            file.reset();
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    for (const auto& item : removed) {
+        if (item->type != ResourceType::CSTR) continue;
+        if (building) {
+            pendingRemovals.push_back(item);
+        } else {
+            RemoveItem(data, item.get());
+        }
+    }
+    for (auto& [item, text] : texts) {
+        if (building) {
+            pendingUpdates.emplace_back(item, std::move(text));
+        } else {
+            AddDocument(data, item, std::move(text));
+        }
+    }
+}
+
+void StringIndex::RemoveItem(Data& index, const ResourceItem* item) {
+    auto found = index.documentByItem.find(item);
+    if (found == index.documentByItem.end()) return;
+    RemoveDocument(index, found->second);
+    // The slot stays so other documents keep their ids; with no postings it never matches
+    index.documents[found->second].item.reset();
+    index.documentByItem.erase(found);
+}
+
+void StringIndex::AddDocument(Data& index, const std::shared_ptr<ResourceItem>& item, std::string text) {
+    uint32_t id;
+    auto existing = index.documentByItem.find(item.get());
+    if (existing != index.documentByItem.end()) {
+        id = existing->second;
+        RemoveDocument(index, id);
+    } else {
+        id = static_cast<uint32_t>(index.documents.size());
+        index.documents.emplace_back();
+        index.documentByItem[item.get()] = id;
+    }
+
+    Document& document = index.documents[id];
+    document.item = item;
+    document.text = std::move(text);
+
+    std::vector<Word> words = Tokenize(document.text);
+    document.wordOffsets.resize(words.size());
+    document.wordLengths.resize(words.size());
+    for (uint32_t position = 0; position < words.size(); ++position) {
+        document.wordOffsets[position] = words[position].offset;
+        document.wordLengths[position] = words[position].length;
+
+        // Postings stay sorted by (document, position); a fresh build only ever appends
+        std::vector<Posting>& list = index.postings[words[position].text];
+        Posting posting{id, position};
+        if (list.empty() || list.back().document < id || (list.back().document == id && list.back().position < position)) {
+            list.push_back(posting);
+        } else {
+            auto at = std::upper_bound(list.begin(), list.end(), posting, [](const Posting& a, const Posting& b) {
+                return a.document != b.document ? a.document < b.document : a.position < b.position;
+            });
+            list.insert(at, posting);
+        }
+    }
+}
+
+void StringIndex::RemoveDocument(Data& index, uint32_t document) {
+    Document& doc = index.documents[document];
+    std::set<std::string> distinct;
+    for (Word& word : Tokenize(doc.text)) distinct.insert(std::move(word.text));
+
+    for (const std::string& word : distinct) {
+        auto found = index.postings.find(word);
+        if (found == index.postings.end()) continue;
+        std::vector<Posting>& list = found->second;
+        auto first = std::lower_bound(list.begin(), list.end(), document, [](const Posting& p, uint32_t d) { return p.document < d; });
+        auto last = std::upper_bound(first, list.end(), document, [](uint32_t d, const Posting& p) { return d < p.document; });
+        list.erase(first, last);
+        if (list.empty()) index.postings.erase(found);
+    }
+    doc.text.clear();
+    doc.wordOffsets.clear();
+    doc.wordLengths.clear();
+}
+
+std::vector<StringIndex::Posting> StringIndex::FindPhrase(const Data& index, const std::vector<std::string>& words, bool lastIsPrefix) {
+    auto postingsFor = [&index](const std::string& word, bool prefix) {
+        std::vector<Posting> result;
+        if (!prefix) {
+            auto found = index.postings.find(word);
+            if (found != index.postings.end()) result = found->second;
+            return result;
+        }
+        for (auto it = index.postings.lower_bound(word); it != index.postings.end() && it->first.compare(0, word.size(), word) == 0; ++it) {
+            result.insert(result.end(), it->second.begin(), it->second.end());
+        }
+        std::sort(result.begin(), result.end(), [](const Posting& a, const Posting& b) {
+            return a.document != b.document ? a.document < b.document : a.position < b.position;
+        });
+        return result;
+    };
+
+    std::vector<Posting> starts = postingsFor(words[0], lastIsPrefix && words.size() == 1);
+    for (size_t i = 1; i < words.size() && !starts.empty(); ++i) {
+        std::vector<Posting> next = postingsFor(words[i], lastIsPrefix && i + 1 == words.size());
+        auto follows = [&next, i](const Posting& start) {
+            Posting wanted{start.document, start.position + static_cast<uint32_t>(i)};
+            return !std::binary_search(next.begin(), next.end(), wanted, [](const Posting& a, const Posting& b) {
+                return a.document != b.document ? a.document < b.document : a.position < b.position;
+            });
+        };
+        starts.erase(std::remove_if(starts.begin(), starts.end(), follows), starts.end());
+    }
+    return starts;
+}
+
+std::vector<StringMatch> StringIndex::Query(const std::string& query, size_t maxResults) const {
+    std::vector<StringMatch> results;
+    std::vector<Clause> clauses = ParseQuery(query);
+    if (clauses.empty()) return results;
+
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    // Documents matching every clause; the first clause supplies the highlighted match
+    std::vector<Posting> first = FindPhrase(data, clauses[0].words, clauses[0].lastIsPrefix);
+    std::vector<Posting> matches;
+    for (const Posting& posting : first) {
+        if (matches.empty() || matches.back().document != posting.document) matches.push_back(posting);
+    }
+    for (size_t c = 1; c < clauses.size() && !matches.empty(); ++c) {
+        std::vector<Posting> other = FindPhrase(data, clauses[c].words, clauses[c].lastIsPrefix);
+        matches.erase(std::remove_if(matches.begin(), matches.end(), [&other](const Posting& match) {
+            auto it = std::lower_bound(other.begin(), other.end(), match.document, [](const Posting& p, uint32_t d) { return p.document < d; });
+            return it == other.end() || it->document != match.document;
+        }), matches.end());
+    }
+
+    const size_t phraseWords = clauses[0].words.size();
+    for (const Posting& match : matches) {
+        if (results.size() >= maxResults) break;
+        const Document& document = data.documents[match.document];
+        size_t lastWord = match.position + phraseWords - 1;
+        size_t offset = document.wordOffsets[match.position];
+        size_t length = document.wordOffsets[lastWord] + document.wordLengths[lastWord] - offset;
+
+        size_t snippetStart = offset > 30 ? offset - 30 : 0;
+        std::string snippet = document.text.substr(snippetStart, 80);
+        std::replace(snippet.begin(), snippet.end(), '\n', ' ');
+        std::replace(snippet.begin(), snippet.end(), '\r', ' ');
+        results.push_back({document.item, offset, length, std::move(snippet)});
+    }
+    return results;
+}
@@ -0,0 +1,169 @@
+// Round trip of ResourceWriter: build a .res file, save edits that grow, shrink
+// and keep chunk sizes, then load it again and compare every chunk.
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BinaryFile.h"
+#include "ResourceLoader.h"
+#include "ResourceWriter.h"
+
+namespace {
+
+using ChunkKey = std::pair<std::string, uint16_t>;
+
+int failures = 0;
+
+void Check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::fprintf(stderr, "FAILED: %s\n", what.c_str());
+        ++failures;
+    }
+}
+
+std::vector<uint8_t> Payload(size_t size, uint8_t seed) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; ++i) bytes[i] = static_cast<uint8_t>(seed + i * 7);
+    return bytes;
+}
+
+std::string TypeName(const ResourceItem& item) {
+    return item.name.substr(0, item.name.find(' '));
+}
+
+// Loads filename and compares it with expected: one chunk per key, sizes and payload bytes equal
+std::unique_ptr<ResourceIndex> LoadAndCompare(const std::string& filename, Endianness endian,
+                                              const std::map<ChunkKey, std::vector<uint8_t>>& expected,
+                                              const std::string& stage) {
+    auto index = ResourceLoader::LoadResourceFile(filename, endian);
+    Check(index != nullptr, stage + ": file loads");
+    if (!index) return nullptr;
+    Check(index->items.size() == expected.size(), stage + ": chunk count");
+
+    BinaryFile file(filename);
+    ResourceHeaderProbe probe;
+    Check(ResourceLoader::ProbeResourceHeader(file, endian, probe) == ResourceHeaderError::None, stage + ": header probe");
+    Check(probe.endian == endian, stage + ": byte order");
+    Check(probe.header.dataSize == probe.header.dataSegmentSize, stage + ": data size matches segment size");
+
+    for (const auto& item : index->items) {
+        std::string name = item->name;
+        auto found = expected.find(ChunkKey(TypeName(*item), item->number));
+        Check(found != expected.end(), stage + ": unexpected chunk " + name);
+        if (found == expected.end()) continue;
+        Check(item->size == found->second.size(), stage + ": size of " + name);
+        Check(item->offset % 2 == 0, stage + ": " + name + " is word aligned");
+        Check(item->offset + 4 + item->size <= ResourceWriter::HEADER_SIZE + probe.header.dataSegmentSize,
+              stage + ": " + name + " lies inside the data segment");
+
+        file.SetPosition(item->offset);
+        Check(file.ReadLongwordUnsigned(endian) == found->second.size(), stage + ": length field of " + name);
+        Check(file.ReadBytes(found->second.size()) == found->second, stage + ": payload of " + name);
+    }
+    return index;
+}
+
+std::shared_ptr<ResourceItem> FindItem(const ResourceIndex& index, const std::string& type, uint16_t number) {
+    for (const auto& item : index.items) {
+        if (TypeName(*item) == type && item->number == number) return item;
+    }
+    return nullptr;
+}
+
+void RunRoundTrip(const std::filesystem::path& directory, Endianness endian) {
+    const std::string label = endian == Endianness::Little ? "LE" : "BE";
+    const std::string filename = (directory / ("TEST_" + label + ".res")).string();
+
+    // The 70000-byte image pushes the chunks after it past the 64K offset word
+    std::vector<ResourceChunk> chunks = {
+        {"CSTR", 0, Payload(10, 1)},
+        {"IMAG", 1, Payload(70000, 2)},
+        {"CSTR", 1, Payload(11, 3)},
+        {"MMAP", 2, Payload(20, 4)},
+        {"CHAR", 3, Payload(5, 5)},
+    };
+    std::map<ChunkKey, std::vector<uint8_t>> expected;
+    for (const auto& chunk : chunks) expected[ChunkKey(chunk.typeID, chunk.number)] = chunk.payload;
+
+    std::string error;
+    Check(ResourceWriter::WriteResourceFile(filename, endian, chunks, error), label + " write: " + error);
+    auto index = LoadAndCompare(filename, endian, expected, label + " written");
+    if (!index) return;
+    auto past64K = FindItem(*index, "MMAP", 2);
+    Check(past64K && past64K->offset > 0x10000, label + ": MMAP 2 lies past 64K");
+
+    // Same sizes only
+    std::vector<ResourceEdit> edits = {
+        {FindItem(*index, "MMAP", 2), Payload(20, 40)},
+        {FindItem(*index, "CSTR", 0), Payload(10, 41)},
+    };
+    for (const auto& edit : edits) expected[ChunkKey(TypeName(*edit.item), edit.item->number)] = edit.payload;
+    // Saving keeps the file's permissions, which neither a new file nor a temporary one gets
+    const auto privatePerms = std::filesystem::perms::owner_read | std::filesystem::perms::owner_write
+                            | std::filesystem::perms::group_read;
+    std::filesystem::permissions(filename, privatePerms, std::filesystem::perm_options::replace);
+    Check(ResourceWriter::SaveResourceFile(filename, endian, edits, error), label + " same-size save: " + error);
+    Check(std::filesystem::status(filename).permissions() == privatePerms, label + ": permissions kept");
+    index = LoadAndCompare(filename, endian, expected, label + " same-size save");
+    if (!index) return;
+
+    // Grow by an odd amount before the 64K boundary, shrink and keep sizes after it
+    edits = {
+        {FindItem(*index, "CSTR", 0), Payload(1001, 50)},
+        {FindItem(*index, "IMAG", 1), Payload(65000, 51)},
+        {FindItem(*index, "CSTR", 1), Payload(3, 52)},
+        {FindItem(*index, "MMAP", 2), Payload(20, 53)},
+    };
+    for (const auto& edit : edits) expected[ChunkKey(TypeName(*edit.item), edit.item->number)] = edit.payload;
+    Check(ResourceWriter::SaveResourceFile(filename, endian, edits, error), label + " resizing save: " + error);
+    index = LoadAndCompare(filename, endian, expected, label + " resizing save");
+    if (!index) return;
+
+    // Grow again so chunks move back across the 64K boundary
+    edits = {{FindItem(*index, "IMAG", 1), Payload(80000, 60)}};
+    expected[ChunkKey("IMAG", 1)] = edits[0].payload;
+    Check(ResourceWriter::SaveResourceFile(filename, endian, edits, error), label + " growing save: " + error);
+    index = LoadAndCompare(filename, endian, expected, label + " growing save");
+    if (!index) return;
+    auto moved = FindItem(*index, "CHAR", 3);
+    Check(moved && moved->offset > 80000, label + ": CHAR 3 moved past the grown image");
+
+    // An edit made against an outdated index must be refused and leave the file alone
+    ResourceItem stale = *FindItem(*index, "CSTR", 1);
+    stale.size += 2;
+    edits = {{std::make_shared<ResourceItem>(stale), Payload(4, 70)}};
+    Check(!ResourceWriter::SaveResourceFile(filename, endian, edits, error), label + ": stale edit is refused");
+    LoadAndCompare(filename, endian, expected, label + " after refused save");
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        const std::string name = entry.path().filename().string();
+        Check(name == "TEST_LE.res" || name == "TEST_BE.res", label + ": no temporary file left behind (" + name + ")");
+    }
+}
+
+} // namespace
+
+int main() {
+    std::error_code ec;
+    std::filesystem::path directory = std::filesystem::temp_directory_path(ec) / "wime-writer-test";
+    std::filesystem::remove_all(directory, ec);
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        std::fprintf(stderr, "Cannot create %s: %s\n", directory.string().c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    RunRoundTrip(directory, Endianness::Little);
+    RunRoundTrip(directory, Endianness::Big);
+
+    std::filesystem::remove_all(directory, ec);
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("ResourceWriter round trip passed\n");
+    return 0;
+}
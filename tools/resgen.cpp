@@ -0,0 +1,358 @@
+// wime-resgen: writes synthetic games of valid .res files for scale testing.
+// The output loads like real data: wime-cli and the editor open the stub game
+// file it writes next to the .res files.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BinaryFile.h"
+#include "ResourceDecoders.h"
+#include "ResourceWriter.h"
+
+namespace {
+
+// Stub game files that Game::DetectFormat maps to each byte order
+constexpr const char* LITTLE_ENDIAN_GAME = "START.EXE";
+constexpr const char* BIG_ENDIAN_GAME = "WarInMiddleEarth";
+
+// The identifier word holds count - 1, but ResourceLoader adds 1 to it in 16 bits
+constexpr size_t MAX_CHUNKS_PER_TYPE = 65535;
+// MAP_HEADER_BYTES counts the length word, but the chunk size ReadMap subtracts the
+// overhead from does not, so the payload's trailer is 4 bytes longer than the difference
+constexpr size_t MAP_TRAILER_BYTES = ResourceDecoders::MAP_CHUNK_OVERHEAD - ResourceDecoders::MAP_HEADER_BYTES + 4;
+
+enum ChunkKind { KIND_CHAR, KIND_CSTR, KIND_MMAP, KIND_IMAG, KIND_COUNT };
+constexpr const char* KIND_IDS[KIND_COUNT] = {"CHAR", "CSTR", "MMAP", "IMAG"};
+
+struct Options {
+    std::string outputDirectory;
+    Endianness endian = Endianness::Little;
+    size_t counts[KIND_COUNT] = {16, 1000, 64, 64};
+    uint32_t mapWidth = ResourceDecoders::DEFAULT_GRID_WIDTH;
+    uint32_t mapHeight = ResourceDecoders::DEFAULT_GRID_HEIGHT;
+    uint32_t imageWidth = 320;
+    uint32_t imageHeight = 200;
+    uint32_t imagePlanes = 4;
+    uint32_t stringLength = 200;       // Average CSTR length in bytes
+    uint32_t runLength = 8;            // Average run of repeated map tiles; 1 is incompressible
+    size_t maxFileSize = static_cast<size_t>(ResourceWriter::MAX_RELATIVE_OFFSET) + 1;
+    uint32_t seed = 1;
+    std::string prefix = "GEN";
+};
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: wime-resgen <out-dir> [options]\n"
+        "\n"
+        "Writes <out-dir>/<prefix>NNN.res plus a stub game file (%s or %s)\n"
+        "that wime-cli and the editor can open. Chunk types are interleaved, and a new\n"
+        ".res file is started whenever the next chunk would not fit in --max-file-size.\n"
+        "\n"
+        "Options:\n"
+        "  --endian <le|be>     Byte order (default: le)\n"
+        "  --char <n>           Number of CHAR tilesets (default: 16)\n"
+        "  --cstr <n>           Number of CSTR strings (default: 1000)\n"
+        "  --mmap <n>           Number of MMAP maps (default: 64)\n"
+        "  --imag <n>           Number of IMAG images (default: 64)\n"
+        "  --map-size <WxH>     Map grid in tiles (default: 160x99)\n"
+        "  --image-size <WxH>   Image size in pixels (default: 320x200)\n"
+        "  --planes <n>         Image bitplanes (default: 4)\n"
+        "  --string-length <n>  Average CSTR length in bytes (default: 200)\n"
+        "  --run-length <n>     Average run of repeated map tiles for ByteRun (default: 8, 1 = noise)\n"
+        "  --max-file-size <n>  Bytes per .res file, at most 16M (default: 16M); accepts K/M suffixes\n"
+        "  --prefix <name>      .res file name prefix (default: GEN)\n"
+        "  --seed <n>           Random seed (default: 1)\n",
+        LITTLE_ENDIAN_GAME, BIG_ENDIAN_GAME);
+}
+
+bool ParseSize(const char* text, size_t& value) {
+    char* end = nullptr;
+    unsigned long long number = std::strtoull(text, &end, 10);
+    if (end == text) return false;
+    if (*end == 'K' || *end == 'k') { number <<= 10; ++end; }
+    else if (*end == 'M' || *end == 'm') { number <<= 20; ++end; }
+    else if (*end == 'G' || *end == 'g') { number <<= 30; ++end; }
+    if (*end != '\0') return false;
+    value = static_cast<size_t>(number);
+    return true;
+}
+
+bool ParseDimensions(const char* text, uint32_t& width, uint32_t& height) {
+    unsigned w = 0, h = 0;
+    if (std::sscanf(text, "%ux%u", &w, &h) != 2 || w == 0 || h == 0) return false;
+    width = w;
+    height = h;
+    return true;
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool valid = true;
+        size_t number = 0;
+        if (arg == "--endian" && hasValue) {
+            std::string value = argv[++i];
+            valid = value == "le" || value == "be";
+            options.endian = value == "be" ? Endianness::Big : Endianness::Little;
+        } else if ((arg == "--char" || arg == "--cstr" || arg == "--mmap" || arg == "--imag") && hasValue) {
+            valid = ParseSize(argv[++i], number);
+            for (int kind = 0; kind < KIND_COUNT; ++kind) {
+                std::string flag = std::string("--") + KIND_IDS[kind];
+                std::transform(flag.begin(), flag.end(), flag.begin(), ::tolower);
+                if (arg == flag) options.counts[kind] = number;
+            }
+        } else if (arg == "--map-size" && hasValue) {
+            valid = ParseDimensions(argv[++i], options.mapWidth, options.mapHeight)
+                 && options.mapWidth <= ResourceDecoders::MAX_GRID_DIMENSION
+                 && options.mapHeight <= ResourceDecoders::MAX_GRID_DIMENSION;
+        } else if (arg == "--image-size" && hasValue) {
+            valid = ParseDimensions(argv[++i], options.imageWidth, options.imageHeight)
+                 && options.imageWidth <= ResourceDecoders::MAX_IMAGE_DIMENSION
+                 && options.imageHeight <= ResourceDecoders::MAX_IMAGE_DIMENSION;
+        } else if (arg == "--planes" && hasValue) {
+            valid = ParseSize(argv[++i], number) && number >= 1 && number <= 8;
+            options.imagePlanes = static_cast<uint32_t>(number);
+        } else if (arg == "--string-length" && hasValue) {
+            valid = ParseSize(argv[++i], number) && number >= 1;
+            options.stringLength = static_cast<uint32_t>(number);
+        } else if (arg == "--run-length" && hasValue) {
+            valid = ParseSize(argv[++i], number) && number >= 1;
+            options.runLength = static_cast<uint32_t>(number);
+        } else if (arg == "--max-file-size" && hasValue) {
+            valid = ParseSize(argv[++i], number) && number >= 64 * 1024
+                 && number <= static_cast<size_t>(ResourceWriter::MAX_RELATIVE_OFFSET) + 1;
+            options.maxFileSize = number;
+        } else if (arg == "--prefix" && hasValue) {
+            options.prefix = argv[++i];
+        } else if (arg == "--seed" && hasValue) {
+            valid = ParseSize(argv[++i], number);
+            options.seed = static_cast<uint32_t>(number);
+        } else if (arg.rfind("--", 0) == 0) {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        } else {
+            positional.push_back(arg);
+        }
+        if (!valid) {
+            std::fprintf(stderr, "Invalid value for %s: %s\n", arg.c_str(), argv[i]);
+            return false;
+        }
+    }
+    if (positional.size() != 1) return false;
+    options.outputDirectory = positional[0];
+    return true;
+}
+
+class ChunkGenerator {
+public:
+    explicit ChunkGenerator(const Options& options) : options(options), random(options.seed) {}
+
+    std::vector<uint8_t> Payload(ChunkKind kind) {
+        switch (kind) {
+            case KIND_CHAR: return TileData();
+            case KIND_CSTR: return Text();
+            case KIND_MMAP: return Map();
+            case KIND_IMAG: return Image();
+            default: return {};
+        }
+    }
+
+private:
+    const Options& options;
+    std::mt19937 random;
+
+    void FillRandom(uint8_t* data, size_t size) {
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            uint32_t value = random();
+            std::memcpy(data + i, &value, 4);
+        }
+        for (; i < size; ++i) data[i] = static_cast<uint8_t>(random());
+    }
+
+    void PutWord(std::vector<uint8_t>& out, size_t position, uint32_t value) {
+        uint16_t word = static_cast<uint16_t>(value);
+        out[position + (options.endian == Endianness::Big ? 1 : 0)] = static_cast<uint8_t>(word & 0xFF);
+        out[position + (options.endian == Endianness::Big ? 0 : 1)] = static_cast<uint8_t>(word >> 8);
+    }
+
+    std::vector<uint8_t> TileData() {
+        std::vector<uint8_t> data(ResourceDecoders::TILE_COUNT * ResourceDecoders::TILE_BYTES);
+        FillRandom(data.data(), data.size());
+        return data;
+    }
+
+    std::vector<uint8_t> Text() {
+        static const char* words[] = {
+            "the", "ring", "of", "shire", "orc", "army", "moves", "north", "gandalf", "frodo",
+            "road", "east", "rohan", "gondor", "mordor", "river", "ford", "tower", "dark", "hobbit"};
+        size_t length = 1 + random() % (2 * options.stringLength);
+        std::string text;
+        text.reserve(length + 16);
+        while (text.size() < length) {
+            if (!text.empty()) text += ' ';
+            text += words[random() % (sizeof(words) / sizeof(words[0]))];
+        }
+        text.resize(length);
+        return std::vector<uint8_t>(text.begin(), text.end());
+    }
+
+    // Grid header, ByteRun cells, then the trailer bytes ReadMap skips
+    std::vector<uint8_t> Map() {
+        std::vector<uint8_t> cells(static_cast<size_t>(options.mapWidth) * options.mapHeight);
+        size_t i = 0;
+        while (i < cells.size()) {
+            size_t run = options.runLength > 1 ? 1 + random() % (2 * options.runLength - 1) : 1;
+            uint8_t tile = static_cast<uint8_t>(random());
+            for (size_t n = 0; n < run && i < cells.size(); ++n) cells[i++] = tile;
+        }
+        std::vector<uint8_t> encoded = ResourceWriter::EncodeByteRun(cells.data(), cells.size());
+
+        const size_t header = ResourceDecoders::MAP_HEADER_BYTES - 4;
+        std::vector<uint8_t> payload(header + encoded.size() + MAP_TRAILER_BYTES, 0);
+        PutWord(payload, 0, options.mapWidth);
+        PutWord(payload, 2, options.mapHeight);
+        std::copy(encoded.begin(), encoded.end(), payload.begin() + header);
+        return payload;
+    }
+
+    std::vector<uint8_t> Image() {
+        const size_t header = ResourceDecoders::IMAGE_HEADER_BYTES - 4;
+        size_t planar = ResourceDecoders::PlanarImageBytes(options.imageWidth, options.imageHeight, options.imagePlanes);
+        std::vector<uint8_t> payload(header + planar);
+        PutWord(payload, 0, options.imageWidth);
+        PutWord(payload, 2, options.imageHeight);
+        FillRandom(payload.data() + header, planar);
+        return payload;
+    }
+};
+
+// Evenly interleaved chunk kinds, so every file gets a share of each type
+class KindSequence {
+public:
+    explicit KindSequence(const size_t* counts) {
+        for (int kind = 0; kind < KIND_COUNT; ++kind) {
+            remaining[kind] = counts[kind];
+            total += counts[kind];
+        }
+    }
+
+    bool Next(ChunkKind& kind) {
+        if (emitted == total) return false;
+        // The kind furthest behind its share of the output so far
+        double best = -1.0;
+        for (int k = 0; k < KIND_COUNT; ++k) {
+            if (remaining[k] == 0) continue;
+            double behind = static_cast<double>(remaining[k]) / (total - emitted);
+            if (behind > best) {
+                best = behind;
+                kind = static_cast<ChunkKind>(k);
+            }
+        }
+        remaining[kind]--;
+        emitted++;
+        return true;
+    }
+
+private:
+    size_t remaining[KIND_COUNT] = {};
+    size_t total = 0;
+    size_t emitted = 0;
+};
+
+struct FileBuilder {
+    std::vector<ResourceChunk> chunks;
+    size_t dataSize = 0;
+    size_t perKind[KIND_COUNT] = {};
+
+    bool Fits(ChunkKind kind, size_t payloadSize, size_t maxFileSize) const {
+        if (perKind[kind] >= MAX_CHUNKS_PER_TYPE) return false;
+        size_t chunkSize = 4 + payloadSize + (payloadSize & 1);
+        size_t trailer = ResourceWriter::TRAILER_PREFIX + 2 + KIND_COUNT * ResourceWriter::IDENTIFIER_SIZE
+                       + (chunks.size() + 1) * ResourceWriter::KEY_ENTRY_SIZE;
+        return ResourceWriter::HEADER_SIZE + dataSize + chunkSize + trailer <= maxFileSize;
+    }
+
+    void Add(ChunkKind kind, std::vector<uint8_t> payload) {
+        ResourceChunk chunk;
+        chunk.typeID = KIND_IDS[kind];
+        chunk.number = static_cast<uint16_t>(perKind[kind]++);
+        dataSize += 4 + payload.size() + (payload.size() & 1);
+        chunk.payload = std::move(payload);
+        chunks.push_back(std::move(chunk));
+    }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(options.outputDirectory, ec);
+    if (ec) {
+        std::fprintf(stderr, "Cannot create %s: %s\n", options.outputDirectory.c_str(), ec.message().c_str());
+        return 2;
+    }
+
+    const char* gameName = options.endian == Endianness::Big ? BIG_ENDIAN_GAME : LITTLE_ENDIAN_GAME;
+    std::ofstream(std::filesystem::path(options.outputDirectory) / gameName, std::ios::binary) << "WIME synthetic game\n";
+
+    auto start = std::chrono::steady_clock::now();
+    ChunkGenerator generator(options);
+    KindSequence sequence(options.counts);
+    FileBuilder file;
+    size_t fileCount = 0;
+    size_t chunkCount = 0;
+    uint64_t bytesWritten = 0;
+
+    auto flush = [&]() -> bool {
+        char name[64];
+        std::snprintf(name, sizeof(name), "%03zu.res", fileCount);
+        std::string path = (std::filesystem::path(options.outputDirectory) / (options.prefix + name)).string();
+        std::string error;
+        if (!ResourceWriter::WriteResourceFile(path, options.endian, file.chunks, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return false;
+        }
+        bytesWritten += std::filesystem::file_size(path, ec);
+        chunkCount += file.chunks.size();
+        fileCount++;
+        file = FileBuilder();
+        return true;
+    };
+
+    ChunkKind kind = KIND_CHAR;
+    while (sequence.Next(kind)) {
+        std::vector<uint8_t> payload = generator.Payload(kind);
+        // An empty file has nothing to flush; the chunk alone is too big
+        if (!file.chunks.empty() && !file.Fits(kind, payload.size(), options.maxFileSize)) {
+            if (!flush()) return 3;
+        }
+        if (!file.Fits(kind, payload.size(), options.maxFileSize)) {
+            std::fprintf(stderr, "A %s chunk of %zu bytes does not fit in --max-file-size\n", KIND_IDS[kind], payload.size());
+            return 3;
+        }
+        file.Add(kind, std::move(payload));
+    }
+    if (!file.chunks.empty() && !flush()) return 3;
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("Wrote %zu chunks to %zu .res files, %.1f MB in %.2f s (%s, open %s)\n", chunkCount, fileCount,
+                bytesWritten / 1048576.0, seconds, options.endian == Endianness::Big ? "big-endian" : "little-endian",
+                (std::filesystem::path(options.outputDirectory) / gameName).string().c_str());
+    return 0;
+}